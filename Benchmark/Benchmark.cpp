@@ -0,0 +1,270 @@
+// Benchmark.cpp
+// Reproducible timing of LabelManager::Run, PulseSolver::Run and
+// BucketGraphSolver::Run against solveMIP on seeded instance families. Every
+// (family, instance) pair is generated from a fixed seed, so two builds run on
+// exactly the same graphs.
+// For the pulse method the labels column counts pulses. process_peak_rss_kb
+// is the high-water mark of the whole benchmark process when the row was
+// taken: it never decreases, so it is not the footprint of that method alone.
+//
+// Usage: Benchmark [--reps N] [--instances N] [--seed S] [--no-mip]
+//                  [--csv FILE] [--json FILE]
+// Results go to benchmark.csv unless --csv/--json is given (solveMIP writes
+// its own log to stdout).
+#include <gurobi_c++.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "Graph.h"
+#include "LabelManager.h"
+#include "PulseSolver.h"
+#include "BucketGraphSolver.h"
+#include "MIP.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// One instance family: complete digraph, costs with a given share of
+// negative arcs, integer resources in [1, 4] and res_max as a fraction of
+// what a Hamiltonian tour would consume.
+struct Family {
+    std::string name;
+    int num_nodes;
+    int num_res;
+    double negative_share;
+    double tightness;
+};
+
+struct Measurement {
+    std::string family;
+    int instance = 0;
+    std::string method;
+    std::vector<double> seconds{};
+    long long labels = 0;
+    bool has_objective = false;     // solveMIP does not return its objective
+    double objective = 0;
+    long long process_peak_rss_kb = 0;     // peakRSS() after the method ran
+};
+
+std::vector<Family> defaultFamilies() {
+    std::vector<Family> families;
+    for (int n : {10, 15, 20}) {
+        for (int m : {1, 3, 5}) {
+            for (double neg : {0.3, 0.7}) {
+                for (double tight : {0.25, 0.5}) {
+                    std::ostringstream name;
+                    name << "n" << n << "_m" << m << "_neg" << neg << "_t" << tight;
+                    families.push_back({ name.str(), n, m, neg, tight });
+                }
+            }
+        }
+    }
+    return families;
+}
+
+Graph makeInstance(const Family& family, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> consumption(1, 4);
+    const int n = family.num_nodes, m = family.num_res;
+    std::vector<double> res_max(m, std::max(4.0, std::floor(family.tightness * n * 2.5)));
+    Graph graph(n, m, res_max);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i == j) continue;
+            std::vector<double> resources(m);
+            for (int k = 0; k < m; ++k) resources[k] = consumption(gen);
+            double cost = unit(gen) * 5 * (unit(gen) < family.negative_share ? -1 : 1);
+            graph.addEdge(i, j, cost, resources);
+        }
+    }
+    return graph;
+}
+
+// High-water mark of the resident set of the whole process since it started,
+// in KiB
+long long peakRSS() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Nearest-rank percentile of an unsorted sample
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+    return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+template <class F>
+double timeIt(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void writeCSV(const std::vector<Measurement>& results, std::ostream& out) {
+    out << "family,instance,method,reps,median_s,p95_s,labels,objective,process_peak_rss_kb\n";
+    for (const Measurement& r : results) {
+        out << r.family << ',' << r.instance << ',' << r.method << ',' << r.seconds.size() << ','
+            << percentile(r.seconds, 0.5) << ',' << percentile(r.seconds, 0.95) << ','
+            << r.labels << ',';
+        if (r.has_objective) out << r.objective;
+        out << ',' << r.process_peak_rss_kb << '\n';
+    }
+}
+
+void writeJSON(const std::vector<Measurement>& results, std::ostream& out) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Measurement& r = results[i];
+        out << "  {\"family\": \"" << r.family << "\", \"instance\": " << r.instance
+            << ", \"method\": \"" << r.method << "\", \"reps\": " << r.seconds.size()
+            << ", \"median_s\": " << percentile(r.seconds, 0.5)
+            << ", \"p95_s\": " << percentile(r.seconds, 0.95)
+            << ", \"labels\": " << r.labels << ", \"objective\": ";
+        if (r.has_objective) out << r.objective;
+        else out << "null";
+        out << ", \"process_peak_rss_kb\": " << r.process_peak_rss_kb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+}
+
+
+int main(int argc, char* argv[]) {
+    int reps = 5, instances = 3;
+    unsigned seed = 12345;
+    bool run_mip = true;
+    std::string csv_path, json_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "missing value for " << arg << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--reps") reps = std::max(1, std::stoi(next()));
+        else if (arg == "--instances") instances = std::max(1, std::stoi(next()));
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::stoul(next()));
+        else if (arg == "--no-mip") run_mip = false;
+        else if (arg == "--csv") csv_path = next();
+        else if (arg == "--json") json_path = next();
+        else {
+            std::cerr << "usage: Benchmark [--reps N] [--instances N] [--seed S] [--no-mip] [--csv FILE] [--json FILE]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<Measurement> results;
+    std::vector<Family> families = defaultFamilies();
+    for (size_t f = 0; f < families.size(); ++f) {
+        for (int inst = 0; inst < instances; ++inst) {
+            unsigned instance_seed = seed + static_cast<unsigned>(f * 1000 + inst);
+            Graph graph = makeInstance(families[f], instance_seed);
+            graph.eliminateArcs();
+            graph.getMaxValue();
+            graph.getMinWeights();
+            graph.getCompletionBounds();
+            graph.buildBaseModel();
+            graph.buildSepModel();
+
+            Measurement labeling{ families[f].name, inst, "labeling" };
+            for (int r = 0; r < reps; ++r) {
+                double seconds = timeIt([&] {
+                    LabelManager manager(graph);
+                    manager.Run(graph);
+                    labeling.labels = manager.stats.get(Counter::LABELS_CREATED);
+                    labeling.has_objective = true;
+                    labeling.objective = manager.solutions.empty() ? 0 : manager.solutions.back().cost;
+                });
+                labeling.seconds.push_back(seconds);
+            }
+            labeling.process_peak_rss_kb = peakRSS();
+            results.push_back(labeling);
+
+            Measurement pulse{ families[f].name, inst, "pulse" };
+            for (int r = 0; r < reps; ++r) {
+                double seconds = timeIt([&] {
+                    PulseSolver solver(graph);
+                    solver.Run();
+                    pulse.labels = solver.stats.get(Counter::LABELS_CREATED);
+                    pulse.has_objective = true;
+                    pulse.objective = solver.solutions.empty() ? 0 : solver.solutions.back().cost;
+                });
+                pulse.seconds.push_back(seconds);
+            }
+            pulse.process_peak_rss_kb = peakRSS();
+            results.push_back(pulse);
+
+            Measurement bucket{ families[f].name, inst, "bucket" };
+            for (int r = 0; r < reps; ++r) {
+                double seconds = timeIt([&] {
+                    BucketGraphSolver solver(graph);
+                    solver.Run();
+                    bucket.labels = solver.stats.get(Counter::LABELS_CREATED);
+                    bucket.has_objective = true;
+                    bucket.objective = solver.solutions.empty() ? 0 : solver.solutions.back().cost;
+                });
+                bucket.seconds.push_back(seconds);
+            }
+            bucket.process_peak_rss_kb = peakRSS();
+            results.push_back(bucket);
+
+            if (run_mip) {
+                Measurement mip{ families[f].name, inst, "mip" };
+                for (int r = 0; r < reps; ++r) {
+                    mip.seconds.push_back(timeIt([&] { solveMIP(graph, false); }));
+                }
+                mip.process_peak_rss_kb = peakRSS();
+                results.push_back(mip);
+            }
+            std::cerr << families[f].name << " #" << inst << ": labeling median "
+                << percentile(labeling.seconds, 0.5) << " s, " << labeling.labels << " labels" << std::endl;
+        }
+    }
+
+    if (csv_path.empty() && json_path.empty()) {
+        csv_path = "benchmark.csv";
+    }
+    if (!csv_path.empty()) {
+        std::ofstream out(csv_path);
+        writeCSV(results, out);
+    }
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        writeJSON(results, out);
+    }
+    return 0;
+}
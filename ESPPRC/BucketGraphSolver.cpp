@@ -0,0 +1,219 @@
+#include "BucketGraphSolver.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    const double INF = std::numeric_limits<double>::infinity();
+}
+
+BucketGraphSolver::BucketGraphSolver(Graph& graph, int num_buckets)
+    : graph(graph), num_buckets(std::max(num_buckets, 1)) {
+    if (!graph.frozen) graph.freeze();
+    if (!graph.completion.ready()) graph.getCompletionBounds();
+    crit_res = graph.criticalResource();
+    if (crit_res < 0) this->num_buckets = 1;
+    step = crit_res >= 0 && graph.res_max[crit_res] > 0 ? graph.res_max[crit_res] / this->num_buckets : 1;
+    restoreArcs();
+}
+
+
+void BucketGraphSolver::restoreArcs() {
+    arc_alive.assign(static_cast<size_t>(num_buckets) * graph.getCSR(true).size(), 1);
+}
+
+
+int BucketGraphSolver::numBucketArcs() const {
+    return static_cast<int>(std::count(arc_alive.begin(), arc_alive.end(), 1));
+}
+
+
+int BucketGraphSolver::bucketOf(const Label& label) const {
+    if (crit_res < 0) return 0;
+    int b = static_cast<int>(std::floor(label.resources[crit_res] / step));
+    return std::clamp(b, 0, num_buckets - 1);
+}
+
+
+std::vector<int> BucketGraphSolver::getPath(LabelHandle handle) const {
+    std::vector<int> path;
+    for (; handle != NO_LABEL; handle = pool[handle].parent) {
+        path.push_back(pool[handle].vertex);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+
+const std::vector<Solution>& BucketGraphSolver::Run() {
+    UB = 0;
+    solutions.clear();
+    stats.reset();
+    label(UB, true);
+    return solutions;
+}
+
+
+// Labels every bucket in increasing order. Labels whose completion bound
+// reaches bound are dropped; with record, complete paths below UB become
+// solutions and bound follows UB.
+void BucketGraphSolver::label(double bound, bool record) {
+    if (graph.ng.active()) {
+        throw std::invalid_argument("BucketGraphSolver does not support ng-route neighborhoods (Graph::ng)");
+    }
+    TRACE_SPAN("bucket labeling");
+    const int n = graph.num_nodes;
+    pool.clear();
+    buckets.assign(static_cast<size_t>(n) * num_buckets, {});
+    min_cost.assign(buckets.size(), INF);
+    pending.assign(num_buckets, {});
+
+    LabelHandle root = pool.allocate();
+    pool[root] = Label(graph, true);
+    pool[root].LB = graph.completion.rootBound();
+    pool[root].id = 0;
+    insert(root);
+    for (int b = 0; b < num_buckets; ++b) {
+        // extensions that stay in bucket b are appended while it is processed
+        while (!pending[b].empty()) {
+            LabelHandle handle = pending[b].back();
+            pending[b].pop_back();
+            if (pool[handle].status == LabelStatus::DOMINATED) continue;
+            extend(handle, record ? UB : bound, record);
+        }
+    }
+}
+
+
+void BucketGraphSolver::extend(LabelHandle handle, double bound, bool record) {
+    const CSR& csr = graph.getCSR(true);
+    const int num_arcs = csr.size();
+    Label& parent = pool[handle];
+    parent.status = LabelStatus::CLOSED;
+    const int v = parent.vertex;
+    const size_t bucket_arcs = static_cast<size_t>(bucketOf(parent)) * num_arcs;
+    for (int arc = csr.begin(v); arc < csr.end(v); ++arc) {
+        if (!arc_alive[bucket_arcs + arc]) continue;
+        const int w = csr.to[arc];
+        if (w == 0) {
+            if (!record || v == 0) continue;
+            const double* arc_res = csr.resources(arc);
+            bool fits = true;
+            for (int k = 0; k < graph.num_res && fits; ++k) {
+                fits = parent.resources[k] + arc_res[k] <= graph.res_max[k];
+            }
+            double cost = parent.cost + csr.cost[arc];
+            if (fits && cost < UB) {
+                std::vector<int> path = getPath(handle);
+                path.push_back(0);
+                solutions.emplace_back(Solution(path, cost, { parent.id, -1 }));
+                UB = cost;
+                bound = cost;
+            }
+            continue;
+        }
+        if (!parent.reaches(w, graph)) continue;
+
+        LabelHandle child = pool.allocate();
+        Label& label = pool[child];     // chunks never move, parent stays valid
+        label.extendFrom(parent, handle, graph, arc, bound);
+        STATS_ADD(stats, Counter::LABELS_CREATED, 1);
+        if (label.status != LabelStatus::DOMINATED) {
+            label.LB = label.cost + graph.completion.completion(true, w, label.resources, label.length);
+            if (label.LB >= bound) label.status = LabelStatus::DOMINATED;
+        }
+        if (label.status == LabelStatus::DOMINATED) {
+            STATS_ADD(stats, Counter::BOUND_PRUNED, 1);
+            pool.release(child);
+            continue;
+        }
+        insert(child);
+    }
+}
+
+
+// Dominance against the buckets of the label's vertex, then publish it
+void BucketGraphSolver::insert(LabelHandle handle) {
+    Label& label = pool[handle];
+    const int b = bucketOf(label);
+    const size_t base = static_cast<size_t>(label.vertex) * num_buckets;
+    // labels of lower buckets use less of the critical resource and can only
+    // dominate the new one, labels of higher buckets can only be dominated
+    for (int bb = 0; bb <= b; ++bb) {
+        if (min_cost[base + bb] > label.cost) continue;
+        for (LabelHandle rival : buckets[base + bb]) {
+            if (pool[rival].DominanceCheck(label) == DominanceStatus::DOMINATES) {
+                STATS_ADD(stats, Counter::DOMINATED, 1);
+                pool.release(handle);
+                return;
+            }
+        }
+    }
+    for (int bb = b; bb < num_buckets; ++bb) {
+        std::vector<LabelHandle>& bucket = buckets[base + bb];
+        double cheapest = INF;
+        for (size_t i = 0; i < bucket.size();) {
+            Label& rival = pool[bucket[i]];
+            if (label.DominanceCheck(rival) == DominanceStatus::DOMINATES) {
+                // stays in the pool: its children refer to it
+                STATS_ADD(stats, Counter::DOMINATING, 1);
+                rival.status = LabelStatus::DOMINATED;
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+                continue;
+            }
+            cheapest = std::min(cheapest, rival.cost);
+            ++i;
+        }
+        min_cost[base + bb] = cheapest;
+    }
+    label.status = LabelStatus::OPEN;
+    buckets[base + b].push_back(handle);
+    min_cost[base + b] = std::min(min_cost[base + b], label.cost);
+    pending[b].push_back(handle);
+}
+
+
+// Reduced-cost fixing on the bucket graph: label with threshold as bound,
+// then a bucket arc (v, b) -> w survives only if some label of bucket b of v
+// can take it and complete a path below threshold. Prefixes dominated away
+// or pruned by the bound are covered by the labels that removed them.
+int BucketGraphSolver::eliminateArcs(double threshold) {
+    TRACE_SPAN("bucket arc elimination");
+    label(threshold, false);
+    const CSR& csr = graph.getCSR(true);
+    const int num_arcs = csr.size();
+    int removed = 0;
+    std::vector<double> res(graph.num_res);
+    for (int v = 0; v < graph.num_nodes; ++v) {
+        for (int b = 0; b < num_buckets; ++b) {
+            const std::vector<LabelHandle>& bucket = buckets[static_cast<size_t>(v) * num_buckets + b];
+            for (int arc = csr.begin(v); arc < csr.end(v); ++arc) {
+                char& alive = arc_alive[static_cast<size_t>(b) * num_arcs + arc];
+                if (!alive) continue;
+                const int w = csr.to[arc];
+                const double* arc_res = csr.resources(arc);
+                double best = INF;
+                for (LabelHandle handle : bucket) {
+                    const Label& label = pool[handle];
+                    if (w == 0 ? v == 0 : !label.reaches(w, graph)) continue;
+                    bool fits = true;
+                    for (int k = 0; k < graph.num_res && fits; ++k) {
+                        res[k] = label.resources[k] + arc_res[k];
+                        fits = res[k] <= graph.res_max[k];
+                    }
+                    if (!fits) continue;
+                    double rest = w == 0 ? 0 : graph.completion.completion(true, w, res, label.length + 1);
+                    best = std::min(best, label.cost + csr.cost[arc] + rest);
+                }
+                if (best >= threshold) {
+                    alive = 0;
+                    ++removed;
+                }
+            }
+        }
+    }
+    return removed;
+}
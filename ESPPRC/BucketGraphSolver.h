@@ -0,0 +1,60 @@
+#ifndef BUCKETGRAPHSOLVER_H
+#define BUCKETGRAPHSOLVER_H
+
+#include <vector>
+#include "Graph.h"
+#include "Label.h"
+#include "LabelPool.h"
+#include "Solution.h"
+#include "SolveStats.h"
+
+// Forward labeling over a bucket graph (Sadykov, Uchoa, Pessoa). The critical
+// resource (Graph::criticalResource) is cut into num_buckets equal intervals
+// and every vertex gets one label bucket per interval. Since resources never
+// decrease, a label only produces labels in its own or higher buckets, so the
+// buckets are processed in increasing order and each label is extended once,
+// without an open heap. A new label in bucket b of vertex v is checked
+// against the labels of buckets 0..b of v (skipping buckets whose cheapest
+// label costs more) and removes the labels it dominates in buckets b.. of v.
+// Bucket arcs, i.e. the arcs out of one bucket of a vertex, can be removed
+// for good by eliminateArcs (reduced-cost fixing); Run then skips them.
+// Like LabelManager, UB starts at 0 and solutions is the improving chain,
+// solutions.back() the best path. DSSR (Graph::dssr) is supported, ng-route
+// is not: its memories need LabelManager's ng dominance, so Run and
+// eliminateArcs throw std::invalid_argument while Graph::ng is active (clear
+// it, or use LabelManager::RunNgRoute).
+class BucketGraphSolver {
+public:
+    double UB = 0;
+    std::vector<Solution> solutions;
+    SolveStats stats;
+
+    BucketGraphSolver(Graph& graph, int num_buckets = 32);
+    const std::vector<Solution>& Run();
+    // Removes the bucket arcs through which no path can cost less than
+    // threshold: a path using one is matched by a path at least as cheap (a
+    // dominating prefix) that avoids it. Valid for the current costs; returns
+    // the number of bucket arcs removed.
+    int eliminateArcs(double threshold);
+    void restoreArcs();
+    int numBucketArcs() const;      // alive ones
+
+private:
+    Graph& graph;
+    int num_buckets;
+    int crit_res;
+    double step;
+    LabelPool pool;
+    std::vector<std::vector<LabelHandle>> buckets;  // [v * num_buckets + b]
+    std::vector<double> min_cost;                   // cheapest label of each bucket
+    std::vector<std::vector<LabelHandle>> pending;  // labels still to extend, per bucket index
+    std::vector<char> arc_alive;                    // [b * num_arcs + out-CSR arc]
+
+    int bucketOf(const Label& label) const;
+    void label(double bound, bool record);
+    void extend(LabelHandle handle, double bound, bool record);
+    void insert(LabelHandle handle);
+    std::vector<int> getPath(LabelHandle handle) const;
+};
+
+#endif // BUCKETGRAPHSOLVER_H
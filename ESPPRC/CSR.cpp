@@ -0,0 +1,37 @@
+#include "CSR.h"
+
+void CSR::build(const std::vector<std::vector<std::shared_ptr<Edge>>>& adj, int m) {
+    num_res = m;
+    backing.reset();
+    offset.assign(adj.size() + 1, 0);
+    for (size_t v = 0; v < adj.size(); ++v) {
+        offset[v + 1] = offset[v] + static_cast<int>(adj[v].size());
+    }
+    int total = offset.back();
+    from.resize(total);
+    to.resize(total);
+    edge_id.resize(total);
+    cost.resize(total);
+    res.resize(static_cast<size_t>(total) * m);
+
+    for (size_t v = 0; v < adj.size(); ++v) {
+        int arc = offset[v];
+        for (const auto& e : adj[v]) {
+            from[arc] = e->from;
+            to[arc] = e->to;
+            edge_id[arc] = e->id;
+            cost[arc] = e->cost;
+            for (int k = 0; k < m; ++k) {
+                res[static_cast<size_t>(arc) * m + k] = e->resources[k];
+            }
+            ++arc;
+        }
+    }
+}
+
+// Refresh the cost array from Edge::cost without rebuilding the structure
+void CSR::updateCosts(const std::vector<std::shared_ptr<Edge>>& edges) {
+    for (int arc = 0; arc < size(); ++arc) {
+        cost[arc] = edges[edge_id[arc]]->cost;
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <vector>
+#include <memory>
+#include "Edge.h"
+
+// One array of a CSR: either it owns its elements, or it refers to memory
+// that CSR::backing keeps alive (a mapped binary graph, see loadBinary).
+template <class T>
+class CSRArray {
+public:
+    CSRArray() = default;
+    CSRArray(const CSRArray& other) { *this = other; }
+    CSRArray(CSRArray&& other) noexcept { *this = std::move(other); }
+    CSRArray& operator=(const CSRArray& other) {
+        owned = other.owned;
+        ptr = other.ptr == other.owned.data() ? owned.data() : other.ptr;
+        len = other.len;
+        return *this;
+    }
+    CSRArray& operator=(CSRArray&& other) noexcept {
+        bool viewing = other.ptr != other.owned.data();
+        owned = std::move(other.owned);     // moving keeps the buffer
+        ptr = viewing ? other.ptr : owned.data();
+        len = other.len;
+        other.ptr = nullptr;
+        other.len = 0;
+        return *this;
+    }
+
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    T& back() { return ptr[len - 1]; }
+    const T& back() const { return ptr[len - 1]; }
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    T* begin() { return ptr; }
+    T* end() { return ptr + len; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + len; }
+    void resize(size_t n) {
+        owned.resize(n);
+        ptr = owned.data();
+        len = n;
+    }
+    void assign(size_t n, const T& value) {
+        owned.assign(n, value);
+        ptr = owned.data();
+        len = n;
+    }
+    void view(T* data, size_t n) {
+        owned = std::vector<T>();
+        ptr = data;
+        len = n;
+    }
+
+private:
+    std::vector<T> owned;
+    T* ptr = nullptr;
+    size_t len = 0;
+};
+
+// Frozen compressed sparse row view of one direction of the adjacency lists.
+// The arcs of vertex v occupy [offset[v], offset[v + 1]); cost and resources
+// live in flat arrays (resources with stride num_res) so that label extension
+// walks contiguous memory instead of chasing shared_ptr<Edge>.
+class CSR {
+public:
+    int num_res = 0;
+    CSRArray<int> offset;
+    CSRArray<int> from;
+    CSRArray<int> to;
+    CSRArray<int> edge_id;      // index into Graph::edges
+    CSRArray<double> cost;
+    CSRArray<double> res;
+    std::shared_ptr<void> backing;  // owner of the memory the arrays view, if any
+
+    void build(const std::vector<std::vector<std::shared_ptr<Edge>>>& adj, int m);
+    void updateCosts(const std::vector<std::shared_ptr<Edge>>& edges);
+
+    int begin(int v) const { return offset[v]; }
+    int end(int v) const { return offset[v + 1]; }
+    int size() const { return static_cast<int>(to.size()); }
+    const double* resources(int arc) const { return res.data() + static_cast<size_t>(arc) * num_res; }
+};
+
+#endif // CSR_H
@@ -0,0 +1,83 @@
+#include "CompletionBound.h"
+#include "Graph.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+    const double INF = std::numeric_limits<double>::infinity();
+    const double EPS = 1e-9;
+}
+
+int CompletionBound::units(double consumption) const {
+    if (res_index < 0) return 1;
+    return static_cast<int>(std::floor(consumption / step + EPS));
+}
+
+void CompletionBound::build(const Graph& graph) {
+    num_nodes = graph.num_nodes;
+    const CSR& csr = graph.getCSR(true);
+
+    // Pick the step resource: every arc must consume a positive amount of it,
+    // so that each DP transition spends at least one unit.
+    res_index = -1;
+    budget = num_nodes;
+    step = 1;
+    for (int k = 0; k < graph.num_res; ++k) {
+        double min_res = INF;
+        for (int arc = 0; arc < csr.size(); ++arc) {
+            min_res = std::min(min_res, csr.resources(arc)[k]);
+        }
+        if (!(min_res > 0) || min_res == INF) continue;
+        int b = static_cast<int>(std::floor(graph.res_max[k] / min_res + EPS));
+        if (b < budget) {
+            budget = b;
+            res_index = k;
+            step = min_res;
+            res_max = graph.res_max[k];
+        }
+    }
+    budget = std::max(budget, 1);
+
+    solve(graph, true, fw);
+    solve(graph, false, bw);
+
+    root_bound = INF;
+    for (int arc = csr.begin(0); arc < csr.end(0); ++arc) {
+        int u = units(res_index < 0 ? 0 : csr.resources(arc)[res_index]);
+        if (u > budget) continue;
+        root_bound = std::min(root_bound, csr.cost[arc] + fw[static_cast<size_t>(budget - u) * num_nodes + csr.to[arc]]);
+    }
+}
+
+// table[b][v]: cheapest walk between v and the depot using at most b units
+void CompletionBound::solve(const Graph& graph, bool dir, std::vector<double>& table) const {
+    const CSR& csr = graph.getCSR(dir);
+    const size_t n = num_nodes;
+    table.assign((budget + 1) * n, INF);
+    table[0] = 0;
+    for (int b = 1; b <= budget; ++b) {
+        double* row = table.data() + b * n;
+        const double* prev = row - n;
+        row[0] = 0;
+        for (int v = 1; v < num_nodes; ++v) {
+            double best = prev[v];
+            for (int arc = csr.begin(v); arc < csr.end(v); ++arc) {
+                int w = dir ? csr.to[arc] : csr.from[arc];
+                int u = units(res_index < 0 ? 0 : csr.resources(arc)[res_index]);
+                if (u > b) continue;
+                best = std::min(best, csr.cost[arc] + table[(b - u) * n + w]);
+            }
+            row[v] = best;
+        }
+    }
+}
+
+double CompletionBound::completion(bool dir, int v, const double* resources, int length) const {
+    if (v == 0) return root_bound;
+    int left = res_index < 0 ? budget - (length - 1)
+        : static_cast<int>(std::floor((res_max - resources[res_index]) / step + EPS));
+    if (left < 0) return INF;
+    left = std::min(left, budget);
+    return (dir ? fw : bw)[static_cast<size_t>(left) * num_nodes + v];
+}
@@ -0,0 +1,42 @@
+#ifndef COMPLETIONBOUND_H
+#define COMPLETIONBOUND_H
+
+#include <vector>
+
+class Graph;
+
+// Solver-free lower bound on the cost of completing a partial path.
+// For every vertex and every remaining budget of one "step" resource it holds
+// the cheapest walk back to the depot (forward labels) or from the depot
+// (backward labels), i.e. a resource-constrained shortest path with
+// elementarity relaxed, computed once by dynamic programming over the budget.
+// The step resource is the resource with the coarsest strictly positive arc
+// consumption; if no resource is positive on every arc, the number of arcs
+// (at most num_nodes on an elementary route) is used instead.
+class CompletionBound {
+public:
+    void build(const Graph& graph);
+    bool ready() const { return budget > 0; }
+    // LB contribution of completing a label at vertex v in direction dir
+    double completion(bool dir, int v, const double* resources, int length) const;
+    double completion(bool dir, int v, const std::vector<double>& resources, int length) const {
+        return completion(dir, v, resources.data(), length);
+    }
+    double rootBound() const { return root_bound; }
+    // The arc count is only bounded on elementary routes
+    bool countsArcs() const { return res_index < 0; }
+
+private:
+    int num_nodes = 0;
+    int budget = 0;             // budget units available to a complete route
+    int res_index = -1;         // step resource, -1 for arc count
+    double step = 1;
+    double res_max = 0;
+    double root_bound = 0;
+    std::vector<double> fw, bw; // [units * num_nodes + v]
+
+    void solve(const Graph& graph, bool dir, std::vector<double>& table) const;
+    int units(double consumption) const;
+};
+
+#endif // COMPLETIONBOUND_H
@@ -0,0 +1,24 @@
+#include "CriticalSet.h"
+
+void CriticalSet::enable(int num_nodes) {
+    slots.assign(num_nodes, -1);
+    members.clear();
+}
+
+bool CriticalSet::add(int v) {
+    if (v == 0 || slots[v] >= 0) return false;
+    slots[v] = size();
+    members.push_back(v);
+    return true;
+}
+
+int CriticalSet::addRepeated(const std::vector<int>& path) {
+    std::vector<char> seen(slots.size(), 0);
+    int added = 0;
+    for (int v : path) {
+        if (v == 0) continue;
+        if (seen[v] && add(v)) ++added;
+        seen[v] = 1;
+    }
+    return added;
+}
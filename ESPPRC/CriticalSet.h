@@ -0,0 +1,27 @@
+#ifndef CRITICALSET_H
+#define CRITICALSET_H
+
+#include <vector>
+
+// Decremental state-space relaxation (Righini, Salani). Elementarity is only
+// enforced on the critical vertices; while the set is active, Label::visited
+// and Label::reachable hold one bit per critical vertex (its slot) instead of
+// one per graph vertex, and every other customer may be visited repeatedly.
+class CriticalSet {
+public:
+    void enable(int num_nodes);     // start DSSR with an empty set
+    void clear() { slots.clear(); members.clear(); }
+    bool active() const { return !slots.empty(); }
+    int size() const { return static_cast<int>(members.size()); }
+    int slot(int v) const { return slots[v]; }     // -1 if v is not critical
+    const std::vector<int>& vertices() const { return members; }
+    bool add(int v);
+    // Adds the customers path visits more than once; returns how many
+    int addRepeated(const std::vector<int>& path);
+
+private:
+    std::vector<int> slots;
+    std::vector<int> members;
+};
+
+#endif // CRITICALSET_H
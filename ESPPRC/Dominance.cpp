@@ -0,0 +1,154 @@
+#include "Dominance.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DOMINANCE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+    DominanceStatus resolve(bool dominates, bool dominated, double a_cost, double b_cost) {
+        if (dominates && a_cost <= b_cost) return DominanceStatus::DOMINATES;
+        if (dominated && a_cost >= b_cost) return DominanceStatus::DOMINATED;
+        return DominanceStatus::INCOMPARABLE;
+    }
+
+#ifdef DOMINANCE_X86
+    DominanceStatus kernelSSE2(double a_cost, const double* a_res, const uint64_t* a_bits,
+        double b_cost, const double* b_res, const uint64_t* b_bits,
+        int num_res, int num_words, int a_count, int b_count) {
+        bool dominates = a_cost <= b_cost && b_count <= a_count;
+        bool dominated = a_cost >= b_cost && a_count <= b_count;
+        int k = 0;
+        for (; k + 2 <= num_res && (dominates || dominated); k += 2) {
+            __m128d a = _mm_loadu_pd(a_res + k);
+            __m128d b = _mm_loadu_pd(b_res + k);
+            if (_mm_movemask_pd(_mm_cmpgt_pd(a, b))) dominates = false;
+            if (_mm_movemask_pd(_mm_cmplt_pd(a, b))) dominated = false;
+        }
+        for (; k < num_res && (dominates || dominated); ++k) {
+            if (a_res[k] > b_res[k]) dominates = false;
+            if (a_res[k] < b_res[k]) dominated = false;
+        }
+        int w = 0;
+        for (; w + 2 <= num_words && (dominates || dominated); w += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_bits + w));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b_bits + w));
+            __m128i zero = _mm_setzero_si128();
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_andnot_si128(a, b), zero)) != 0xFFFF) dominates = false;
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_andnot_si128(b, a), zero)) != 0xFFFF) dominated = false;
+        }
+        for (; w < num_words && (dominates || dominated); ++w) {
+            if (b_bits[w] & ~a_bits[w]) dominates = false;
+            if (a_bits[w] & ~b_bits[w]) dominated = false;
+        }
+        return resolve(dominates, dominated, a_cost, b_cost);
+    }
+
+    TARGET_AVX2 DominanceStatus kernelAVX2(double a_cost, const double* a_res, const uint64_t* a_bits,
+        double b_cost, const double* b_res, const uint64_t* b_bits,
+        int num_res, int num_words, int a_count, int b_count) {
+        bool dominates = a_cost <= b_cost && b_count <= a_count;
+        bool dominated = a_cost >= b_cost && a_count <= b_count;
+        int k = 0;
+        for (; k + 4 <= num_res && (dominates || dominated); k += 4) {
+            __m256d a = _mm256_loadu_pd(a_res + k);
+            __m256d b = _mm256_loadu_pd(b_res + k);
+            if (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ))) dominates = false;
+            if (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ))) dominated = false;
+        }
+        for (; k < num_res && (dominates || dominated); ++k) {
+            if (a_res[k] > b_res[k]) dominates = false;
+            if (a_res[k] < b_res[k]) dominated = false;
+        }
+        int w = 0;
+        for (; w + 4 <= num_words && (dominates || dominated); w += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_bits + w));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_bits + w));
+            // testz(x, y) is 1 when x & y == 0: b & ~a == 0 <=> reachable(b) within reachable(a)
+            if (!_mm256_testz_si256(b, _mm256_xor_si256(a, _mm256_set1_epi64x(-1)))) dominates = false;
+            if (!_mm256_testz_si256(a, _mm256_xor_si256(b, _mm256_set1_epi64x(-1)))) dominated = false;
+        }
+        for (; w < num_words && (dominates || dominated); ++w) {
+            if (b_bits[w] & ~a_bits[w]) dominates = false;
+            if (a_bits[w] & ~b_bits[w]) dominated = false;
+        }
+        return resolve(dominates, dominated, a_cost, b_cost);
+    }
+
+    bool cpuHasAVX2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    using Kernel = DominanceStatus(*)(double, const double*, const uint64_t*,
+        double, const double*, const uint64_t*, int, int, int, int);
+
+    struct Dispatch {
+        Kernel kernel = dominanceKernelScalar;
+        const char* name = "scalar";
+        Dispatch() {
+#ifdef DOMINANCE_X86
+            if (cpuHasAVX2()) {
+                kernel = kernelAVX2;
+                name = "avx2";
+            }
+            else {
+                kernel = kernelSSE2;
+                name = "sse2";
+            }
+#endif
+        }
+    };
+
+    const Dispatch& dispatch() {
+        static const Dispatch d;
+        return d;
+    }
+}
+
+DominanceStatus dominanceKernelScalar(double a_cost, const double* a_res, const uint64_t* a_bits,
+    double b_cost, const double* b_res, const uint64_t* b_bits,
+    int num_res, int num_words, int a_count, int b_count) {
+    // reachable(b) within reachable(a) needs popcount(b) <= popcount(a)
+    bool dominates = a_cost <= b_cost && b_count <= a_count;
+    bool dominated = a_cost >= b_cost && a_count <= b_count;
+    for (int k = 0; k < num_res && (dominates || dominated); ++k) {
+        if (a_res[k] > b_res[k]) dominates = false;
+        if (a_res[k] < b_res[k]) dominated = false;
+    }
+    for (int w = 0; w < num_words && (dominates || dominated); ++w) {
+        if (b_bits[w] & ~a_bits[w]) dominates = false;
+        if (a_bits[w] & ~b_bits[w]) dominated = false;
+    }
+    return resolve(dominates, dominated, a_cost, b_cost);
+}
+
+DominanceStatus dominanceKernel(double a_cost, const double* a_res, const uint64_t* a_bits,
+    double b_cost, const double* b_res, const uint64_t* b_bits,
+    int num_res, int num_words, int a_count, int b_count) {
+    return dispatch().kernel(a_cost, a_res, a_bits, b_cost, b_res, b_bits, num_res, num_words, a_count, b_count);
+}
+
+const char* dominanceKernelName() {
+    return dispatch().name;
+}
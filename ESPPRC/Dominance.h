@@ -0,0 +1,30 @@
+#ifndef DOMINANCE_H
+#define DOMINANCE_H
+
+#include <cstdint>
+
+enum class DominanceStatus {
+    DOMINATES,
+    DOMINATED,
+    INCOMPARABLE
+};
+
+// Dominance test between label a and label b at the same vertex.
+// a DOMINATES b if cost, every resource are <= and reachable(a) is a superset
+// of reachable(b); DOMINATED is the symmetric case. Resources are compared in
+// SIMD lanes and reachable sets word-wide (ANDNOT + zero test).
+// a_count and b_count are the popcounts of the sets (0, 0 when unknown): a
+// superset is never smaller, so a direction they rule out is dropped before
+// any resource or word is read.
+// The implementation (AVX2, SSE2 or scalar) is picked once at runtime.
+DominanceStatus dominanceKernel(double a_cost, const double* a_res, const uint64_t* a_bits,
+    double b_cost, const double* b_res, const uint64_t* b_bits,
+    int num_res, int num_words, int a_count = 0, int b_count = 0);
+
+DominanceStatus dominanceKernelScalar(double a_cost, const double* a_res, const uint64_t* a_bits,
+    double b_cost, const double* b_res, const uint64_t* b_bits,
+    int num_res, int num_words, int a_count = 0, int b_count = 0);
+
+const char* dominanceKernelName();
+
+#endif // DOMINANCE_H
@@ -10,20 +10,20 @@
 #include "Edge.h"
 #include "Utils.h"
 #include "MIP.h"
+#include "InstanceLoader.h"
+#include "Tracer.h"
 
 
 
 
 
-int main() {
-    // preprocessing
-    int n = 10, m = 5;
+// Random complete graph with n nodes and m resources
+Graph randomGraph(int n, int m) {
     std::vector<double> res_max(m,0);
 	for (int i = 0; i < m; ++i) {
 		res_max[i] = 25;
 	}
 
-    // build a random graph with n nodes and m resources
     std::srand(std::time(nullptr));
     Graph graph(n, m, res_max);
     
@@ -38,8 +38,23 @@ int main() {
             graph.addEdge(j, i, cost, randomResources);
         }
     }
+    return graph;
+}
+
+
+int main(int argc, char* argv[]) {
+    // preprocessing: load the instance given on the command line (Solomon,
+    // .csv arc list or .bin), otherwise build a random graph
+    // ESPPRC_TRACE=<file> records a Chrome trace of the run
+    const char* trace_path = std::getenv("ESPPRC_TRACE");
+    if (trace_path) Tracer::instance().enable();
+    Graph graph = argc > 1 ? loadInstance(argv[1]) : randomGraph(10, 5);
+    ArcElimination eliminated = graph.eliminateArcs();
+    std::cout << "Arc elimination removed " << eliminated.arcs << " arcs, " << eliminated.vertices
+        << " vertices unreachable (" << eliminated.rounds << " passes)" << std::endl;
     graph.getMaxValue();
     graph.getMinWeights();
+    graph.getCompletionBounds();
 	std::cout << "Building graph based models" << std::endl;
     graph.buildBaseModel();
 	std::cout << "Separation model is built" << std::endl;  
@@ -92,6 +107,8 @@ int main() {
 	//	std::cout << " ESPPRC is slower for " << static_cast<double>((duration_esp - duration_ip))/duration_esp *100<<"%" << std::endl;
  //   }
     manager.displaySolutions();
+    std::cout << "Stats: " << manager.stats.toJSON() << std::endl;
+    if (trace_path) Tracer::instance().writeChromeTrace(trace_path);
     return 0;
 }
 
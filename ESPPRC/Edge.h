@@ -9,6 +9,7 @@ public:
 	int to;
     double cost;
     std::vector<double> resources;
+    int id = -1;
     Edge(int f, int t, double c, const std::vector<double>& r);
 };
 
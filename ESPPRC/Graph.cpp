@@ -2,6 +2,10 @@
 
 #include "Graph.h"
 #include <iostream>
+#include <algorithm>
+#include <queue>
+#include <limits>
+#include "Tracer.h"
 
 // Constructor
 Graph::Graph(int n, int m, std::vector<double> r_max)
@@ -15,11 +19,13 @@ Graph::Graph(int n, int m, std::vector<double> r_max)
 // Method to add an edge to the graph
 void Graph::addEdge(int from, int to, double cost, const std::vector<double>& resources) {
 	auto edge = make_shared<Edge>(from, to, cost, resources);
+    edge->id = static_cast<int>(edges.size());
     OutList[from].push_back(edge);
     InList[to].push_back(edge);
 	edges.push_back(edge);
     num_edges += 1;
 	predecessor[from][to] = true;
+    frozen = false;
 }
 
 // Method to get neighbors of a node
@@ -70,7 +76,18 @@ void Graph::deleteEdge(int from, int to ) {
         InList[to].end()
     );
 	predecessor[from][to] = false;
+    frozen = false;
+}
+// Method to build the CSR views of OutList and InList
+void Graph::freeze() {
+    out_csr.build(OutList, num_res);
+    in_csr.build(InList, num_res);
+    frozen = true;
+    getDepotDistances();
+}
 
+const CSR& Graph::getCSR(bool dir) const {
+    return dir ? out_csr : in_csr;
 }
 // Method to get maximum values
 void Graph::getMaxValue() {
@@ -83,6 +100,163 @@ void Graph::getMaxValue() {
 		//std::cout << "Node " << i << " Min Value: " << max_value[i] << std::endl;
     }
 }
+// Method to precompute the solver-free completion bounds (needs freeze())
+void Graph::getCompletionBounds() {
+    if (!frozen) freeze();
+    completion.build(*this);
+}
+// Method to precompute the multi-step reachability tables from the CSR views
+// (one Dijkstra per resource and direction; walks need not be elementary)
+void Graph::getDepotDistances() {
+    const double INF = std::numeric_limits<double>::infinity();
+    auto dijkstra = [&](bool dir, int k, std::vector<double>& dist) {
+        // dir: walks from the depot along out-arcs, else towards it along in-arcs
+        const CSR& csr = getCSR(dir);
+        dist.assign(num_nodes, INF);
+        dist[0] = 0;
+        using Item = std::pair<double, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+        heap.push({ 0, 0 });
+        while (!heap.empty()) {
+            auto [d, v] = heap.top();
+            heap.pop();
+            if (d > dist[v]) continue;
+            for (int arc = csr.begin(v); arc < csr.end(v); ++arc) {
+                int w = dir ? csr.to[arc] : csr.from[arc];
+                double nd = d + csr.resources(arc)[k];
+                if (nd < dist[w]) {
+                    dist[w] = nd;
+                    heap.push({ nd, w });
+                }
+            }
+        }
+    };
+    to_depot.resize(num_res);
+    from_depot.resize(num_res);
+    visit_fw.assign(num_res, std::vector<double>(num_nodes, INF));
+    visit_bw.assign(num_res, std::vector<double>(num_nodes, INF));
+    for (int k = 0; k < num_res; ++k) {
+        dijkstra(false, k, to_depot[k]);
+        dijkstra(true, k, from_depot[k]);
+        for (int arc = 0; arc < out_csr.size(); ++arc) {
+            int from = out_csr.from[arc], to = out_csr.to[arc];
+            double r = out_csr.resources(arc)[k];
+            visit_fw[k][to] = std::min(visit_fw[k][to], r + to_depot[k][to]);
+            visit_bw[k][from] = std::min(visit_bw[k][from], r + from_depot[k][from]);
+        }
+    }
+}
+// Preprocessing: delete every arc (i, j) that no route can use, i.e. for
+// some resource the cheapest depot -> i walk, the arc and the cheapest
+// j -> depot walk exceed res_max. Vertices that cannot be reached feasibly
+// lose all their arcs this way. Removing arcs can lengthen the depot walks,
+// so passes repeat until nothing changes. Graph::edges keeps the deleted
+// arcs (edge ids stay valid for updateCosts); call this before getMaxValue,
+// getCompletionBounds and buildBaseModel. Leaves the graph frozen.
+ArcElimination Graph::eliminateArcs() {
+    ArcElimination result;
+    std::vector<bool> had_arcs(num_nodes);
+    for (int v = 1; v < num_nodes; ++v) had_arcs[v] = !OutList[v].empty() || !InList[v].empty();
+    if (!frozen) freeze();
+    std::vector<char> drop(num_nodes);
+    std::vector<int> targets;
+    while (true) {
+        int removed = 0;
+        for (int i = 0; i < num_nodes; ++i) {
+            // deleteEdge removes all parallel arcs (i, j): only if none fits
+            targets.clear();
+            for (const auto& e : OutList[i]) {
+                bool fits = true;
+                for (int k = 0; k < num_res && fits; ++k) {
+                    fits = from_depot[k][i] + e->resources[k] + to_depot[k][e->to] <= res_max[k];
+                }
+                if (!drop[e->to]) {
+                    drop[e->to] = fits ? 2 : 1;
+                    targets.push_back(e->to);
+                }
+                else if (fits) {
+                    drop[e->to] = 2;
+                }
+            }
+            for (int j : targets) {
+                if (drop[j] == 1) {
+                    removed += static_cast<int>(std::count_if(OutList[i].begin(), OutList[i].end(),
+                        [j](const std::shared_ptr<Edge>& e) { return e->to == j; }));
+                    deleteEdge(i, j);
+                }
+                drop[j] = 0;
+            }
+        }
+        ++result.rounds;
+        if (removed == 0) break;
+        result.arcs += removed;
+        freeze();
+    }
+    for (int v = 1; v < num_nodes; ++v) {
+        if (had_arcs[v] && OutList[v].empty() && InList[v].empty()) ++result.vertices;
+    }
+    return result;
+}
+// The critical resource is the one arcs consume most of, relative to res_max
+// (-1 without resources)
+int Graph::criticalResource() const {
+    int crit = -1;
+    double tightest = -1;
+    for (int k = 0; k < num_res; ++k) {
+        double total = 0;
+        for (const auto& e : edges) total += e->resources[k];
+        double usage = res_max[k] > 0 ? total / res_max[k] : 0;
+        if (usage > tightest) {
+            tightest = usage;
+            crit = k;
+        }
+    }
+    return crit;
+}
+// Method to change arc costs in place (costs indexed like edges). Only the
+// cost-dependent data is refreshed: CSR costs, max_value, completion bounds
+// and the objectives of model and sep_model, which are re-solved.
+void Graph::updateCosts(const std::vector<double>& costs) {
+    for (const auto& e : edges) {
+        e->cost = costs[e->id];
+    }
+    if (frozen) {
+        out_csr.updateCosts(edges);
+        in_csr.updateCosts(edges);
+    }
+    std::fill(max_value.begin(), max_value.end(), 100.0);
+    getMaxValue();
+    if (completion.ready()) {
+        completion.build(*this);
+    }
+    if (model) {
+        // buildBaseModel puts cost + from on x[from,to]
+        for (const auto& e : edges) {
+            auto it = x_index.find({ e->from, e->to });
+            if (it != x_index.end()) {
+                model->getVar(it->second).set(GRB_DoubleAttr_Obj, e->cost + e->from);
+            }
+        }
+        model->update();
+        model->optimize();
+    }
+    if (sep_model) {
+        // the separation objective holds the current LP solution
+        for (int i = 1; i < num_nodes; ++i) {
+            double y = model->getVar(y_index[i]).get(GRB_DoubleAttr_X);
+            std::string name = "[" + std::to_string(i) + "]";
+            sep_model->getVarByName("z" + name).set(GRB_DoubleAttr_Obj, -y);
+            sep_model->getVarByName("z_" + name).set(GRB_DoubleAttr_Obj, y);
+            for (const auto& e : OutList[i]) {
+                if (e->to == 0) continue;
+                double x = model->getVar(x_index[{ e->from, e->to }]).get(GRB_DoubleAttr_X);
+                sep_model->getVarByName("w[" + std::to_string(e->from) + "," + std::to_string(e->to) + "]").set(GRB_DoubleAttr_Obj, x);
+            }
+        }
+        sep_model->update();
+        sep_model->optimize();
+    }
+}
 bool Graph::is_neighbor(const int from, const int to) const {
 	return predecessor[from][to];
 }
@@ -96,6 +270,7 @@ Edge& Graph::getEdge(int from, int to) const {
 }
 
 void Graph::buildBaseModel(bool LP_relaxation, bool subtour_elm) {
+    TRACE_SPAN("buildBaseModel");
     GRBEnv env = GRBEnv();
     env.set(GRB_IntParam_OutputFlag, 0);
     env.set(GRB_IntParam_LogToConsole, 0);
@@ -186,6 +361,7 @@ void Graph::buildBaseModel(bool LP_relaxation, bool subtour_elm) {
     
 }
 void Graph::buildSepModel() {
+    TRACE_SPAN("buildSepModel");
 	std::cout << "Building separation model" << std::endl;
     GRBEnv enV = GRBEnv();
     enV.set(GRB_IntParam_OutputFlag, 0);
@@ -202,6 +378,13 @@ void Graph::buildSepModel() {
     //std::cout << "starting LB improvement" << std::endl;
     std::string name;
 
+    // Every customer gets its z variables, also one that arc elimination
+    // left without arcs between customers (updateCosts looks them up by name)
+    for (int i = 1; i < num_nodes; ++i) {
+        z[i] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z[" + std::to_string(i) + "]");
+        z_[i] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z_[" + std::to_string(i) + "]");
+    }
+
     for (int i = 1; i < num_nodes; ++i) {
         name = "[" + std::to_string(i) + "]";
         y[i] = model->getVarByName("y" + name).get(GRB_DoubleAttr_X);
@@ -213,14 +396,6 @@ void Graph::buildSepModel() {
             w[{e->from, e->to}] = sep_model->addVar(0, 1, x_val[{e->from, e->to}], GRB_BINARY, "w" + name);
 
             obj += x_val[{e->from, e->to}] * w[{e->from, e->to}];
-            if (z.find(e->from) == z.end()) {
-                z[e->from] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z[" + std::to_string(e->from) + "]");
-                z_[e->from] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z_[" + std::to_string(e->from) + "]");
-            }
-            if (z.find(e->to) == z.end()) {
-                z[e->to] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z[" + std::to_string(e->to) + "]");
-                z_[e->to] = sep_model->addVar(0, 1, 0, GRB_BINARY, "z_[" + std::to_string(e->to) + "]");
-            }
             sep_model->addConstr(2 * w[{e->from, e->to}] <= z[e->from] + z[e->to]);
             sep_model->addConstr(z[e->from] + z[e->to] <= w[{e->from, e->to}] + 1);
 
@@ -5,6 +5,10 @@
 #include <vector>
 #include "Edge.h"
 #include "Label.h"
+#include "CSR.h"
+#include "CompletionBound.h"
+#include "NgNeighborhoods.h"
+#include "CriticalSet.h"
 #include <memory>
 #include <gurobi_c++.h> 
 #include <map>
@@ -13,6 +17,13 @@
 #define ROUND(value, places) (std::round((value) * std::pow(10.0, (places))) / std::pow(10.0, (places)))
 
 
+// What Graph::eliminateArcs removed
+struct ArcElimination {
+    int arcs = 0;           // arcs deleted
+    int vertices = 0;       // customers left without any arc
+    int rounds = 0;         // passes until nothing changed
+};
+
 class Graph {
 public:
     std::vector<std::vector<std::shared_ptr<Edge>>> OutList;
@@ -30,6 +41,20 @@ public:
 	std::map<std::pair<int, int>, int> x_index;
 	std::map<int, int> u_index;
 	std::map<int, int> y_index;
+    // Contiguous adjacency used by the labeling engine; rebuilt by freeze()
+    // once all addEdge/deleteEdge calls are done.
+    CSR out_csr, in_csr;
+    bool frozen = false;
+    CompletionBound completion;
+    // Multi-step reachability (getDepotDistances), per resource k and vertex v:
+    // least consumption of a walk v -> depot (to_depot) and depot -> v
+    // (from_depot); visit_fw adds the cheapest arc into v to to_depot,
+    // visit_bw the cheapest arc out of v to from_depot
+    std::vector<std::vector<double>> to_depot, from_depot, visit_fw, visit_bw;
+    // ng-route relaxation; while inactive the labels are elementary
+    NgNeighborhoods ng;
+    // DSSR critical vertices; takes precedence over ng while active
+    CriticalSet dssr;
 
 
     Graph(int n, int m, std::vector<double> r_max);
@@ -41,7 +66,14 @@ public:
     bool is_neighbor(const int from, const int to) const;
     std::vector<std::vector<double>> getMinWeights();
 	Edge& getEdge(int from, int to) const;
+    void freeze();
+    const CSR& getCSR(bool dir) const;
     void getMaxValue();
+    void getCompletionBounds();
+    void getDepotDistances();
+    ArcElimination eliminateArcs();
+    int criticalResource() const;
+    void updateCosts(const std::vector<double>& costs);
     void buildBaseModel(bool LP_relaxation = true, bool subtour_elm=true);
     std::pair<std::map<std::pair<int, int>, double>, double> getRCLabel(const std::vector<int>& p);
 	void buildSepModel();
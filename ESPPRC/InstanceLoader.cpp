@@ -0,0 +1,327 @@
+#include "InstanceLoader.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char BINARY_MAGIC[4] = { 'E', 'S', 'P', 'G' };
+    const uint32_t BINARY_VERSION = 1;
+
+    // File layout: header, res_max[num_res], offset[num_nodes + 1],
+    // from[num_arcs], to[num_arcs], padding to 8 bytes, cost[num_arcs],
+    // res[num_arcs * num_res]. Arcs are in out-CSR order.
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        int32_t num_nodes;
+        int32_t num_res;
+        int32_t num_arcs;
+        int32_t reserved;
+    };
+
+    size_t align8(size_t bytes) {
+        return (bytes + 7) & ~static_cast<size_t>(7);
+    }
+
+    // Copy-on-write memory mapping of a whole file: the pages can be written
+    // (Graph::updateCosts) without touching the file
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot open " + path);
+            LARGE_INTEGER bytes;
+            GetFileSizeEx(file, &bytes);
+            length = static_cast<size_t>(bytes.QuadPart);
+            mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (mapping) data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+#else
+            fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("cannot open " + path);
+            struct stat st;
+            fstat(fd, &st);
+            length = static_cast<size_t>(st.st_size);
+            void* p = length ? mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            if (p != MAP_FAILED) data = static_cast<char*>(p);
+#endif
+            if (!data) {
+                close();
+                throw std::runtime_error("cannot map " + path);
+            }
+        }
+        ~MappedFile() { close(); }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        char* data = nullptr;
+        size_t length = 0;
+
+    private:
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        void close() {
+            if (data) UnmapViewOfFile(data);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            data = nullptr;
+        }
+#else
+        int fd = -1;
+        void close() {
+            if (data) munmap(data, length);
+            if (fd >= 0) ::close(fd);
+            data = nullptr;
+        }
+#endif
+    };
+
+    std::vector<std::string> splitCSV(const std::string& line) {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) {
+            field.erase(0, field.find_first_not_of(" \t\r"));
+            field.erase(field.find_last_not_of(" \t\r") + 1);
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    bool isNumber(const std::string& s) {
+        if (s.empty()) return false;
+        char* end = nullptr;
+        std::strtod(s.c_str(), &end);
+        return *end == '\0';
+    }
+
+    std::ifstream openText(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        return in;
+    }
+}
+
+
+Graph loadSolomon(const std::string& path, int num_customers, const std::vector<double>& duals) {
+    struct Customer {
+        double x, y, demand, ready, due, service;
+    };
+    std::ifstream in = openText(path);
+    std::vector<Customer> customers;
+    double capacity = -1;
+    bool capacity_next = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::vector<double> values;
+        double value;
+        while (ss >> value) values.push_back(value);
+        if (line.find("CAPACITY") != std::string::npos) {
+            capacity_next = true;
+        }
+        else if (capacity_next && values.size() == 2) {
+            capacity = values[1];
+            capacity_next = false;
+        }
+        else if (values.size() == 7) {
+            customers.push_back({ values[1], values[2], values[3], values[4], values[5], values[6] });
+        }
+    }
+    if (capacity < 0 || customers.size() < 2) throw std::runtime_error("not a Solomon instance: " + path);
+    if (num_customers > 0 && num_customers + 1 < static_cast<int>(customers.size())) {
+        customers.resize(num_customers + 1);
+    }
+
+    const int n = static_cast<int>(customers.size());
+    Graph graph(n, 2, { capacity, customers[0].due });
+    for (int i = 0; i < n; ++i) {
+        const Customer& a = customers[i];
+        double dual = i < static_cast<int>(duals.size()) ? duals[i] : 0;
+        for (int j = 0; j < n; ++j) {
+            if (i == j) continue;
+            const Customer& b = customers[j];
+            double travel = std::floor(std::hypot(a.x - b.x, a.y - b.y) * 10) / 10;
+            // Arcs that can never be served on time or within capacity
+            if (a.ready + a.service + travel > b.due) continue;
+            if (a.demand + b.demand > capacity) continue;
+            graph.addEdge(i, j, travel - dual, { b.demand, a.service + travel });
+        }
+    }
+    return graph;
+}
+
+
+Graph loadArcCSV(const std::string& path) {
+    std::ifstream in = openText(path);
+    int n = -1;
+    std::vector<double> res_max;
+    struct Arc {
+        int from, to;
+        double cost;
+        std::vector<double> resources;
+    };
+    std::vector<Arc> arcs;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        std::vector<std::string> f = splitCSV(line);
+        if (f.empty() || f[0].empty() || f[0][0] == '#') continue;
+        const std::string where = path + ":" + std::to_string(line_no) + ": ";
+        try {
+            if (f[0] == "nodes" && f.size() >= 2) {
+                n = std::stoi(f[1]);
+            }
+            else if (f[0] == "res_max") {
+                res_max.clear();
+                for (size_t k = 1; k < f.size(); ++k) res_max.push_back(std::stod(f[k]));
+            }
+            else if (isNumber(f[0])) {
+                if (f.size() != 3 + res_max.size()) {
+                    throw std::runtime_error(where + "expected " + std::to_string(3 + res_max.size()) + " columns");
+                }
+                Arc arc{ std::stoi(f[0]), std::stoi(f[1]), std::stod(f[2]), {} };
+                for (size_t k = 3; k < f.size(); ++k) arc.resources.push_back(std::stod(f[k]));
+                arcs.push_back(std::move(arc));
+            }
+            // anything else is the column header
+        }
+        catch (const std::logic_error&) {
+            // std::invalid_argument or std::out_of_range from stoi / stod
+            throw std::runtime_error(where + "malformed number");
+        }
+    }
+    if (n <= 0) throw std::runtime_error("missing 'nodes' line in " + path);
+
+    Graph graph(n, static_cast<int>(res_max.size()), res_max);
+    for (const Arc& arc : arcs) {
+        if (arc.from < 0 || arc.from >= n || arc.to < 0 || arc.to >= n) {
+            throw std::runtime_error("arc endpoint out of range in " + path);
+        }
+        graph.addEdge(arc.from, arc.to, arc.cost, arc.resources);
+    }
+    return graph;
+}
+
+
+void saveBinary(const Graph& graph, const std::string& path) {
+    CSR csr;
+    csr.build(graph.OutList, graph.num_res);
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("cannot write " + path);
+
+    BinaryHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, 4);
+    header.version = BINARY_VERSION;
+    header.num_nodes = graph.num_nodes;
+    header.num_res = graph.num_res;
+    header.num_arcs = csr.size();
+    auto write = [&out](const void* p, size_t bytes) {
+        out.write(static_cast<const char*>(p), static_cast<std::streamsize>(bytes));
+    };
+    write(&header, sizeof(header));
+    write(graph.res_max.data(), graph.res_max.size() * sizeof(double));
+    write(csr.offset.data(), csr.offset.size() * sizeof(int32_t));
+    write(csr.from.data(), csr.from.size() * sizeof(int32_t));
+    write(csr.to.data(), csr.to.size() * sizeof(int32_t));
+    size_t ints = (csr.offset.size() + 2 * csr.from.size()) * sizeof(int32_t);
+    const char zeros[8] = {};
+    write(zeros, align8(ints) - ints);
+    write(csr.cost.data(), csr.cost.size() * sizeof(double));
+    write(csr.res.data(), csr.res.size() * sizeof(double));
+    if (!out) throw std::runtime_error("write failed: " + path);
+}
+
+
+Graph loadBinary(const std::string& path) {
+    auto mapped = std::make_shared<MappedFile>(path);
+    MappedFile& file = *mapped;
+    BinaryHeader header;
+    if (file.length < sizeof(header)) throw std::runtime_error("truncated " + path);
+    std::memcpy(&header, file.data, sizeof(header));
+    if (std::memcmp(header.magic, BINARY_MAGIC, 4) != 0 || header.version != BINARY_VERSION) {
+        throw std::runtime_error("not an ESPPRC binary graph: " + path);
+    }
+    if (header.num_nodes <= 0 || header.num_res < 0 || header.num_arcs < 0) {
+        throw std::runtime_error("corrupt header in " + path);
+    }
+    const size_t n = header.num_nodes, m = header.num_res, a = header.num_arcs;
+    // Keeps the size computation below from overflowing
+    if (n > file.length || m > file.length || a > file.length) throw std::runtime_error("truncated " + path);
+    size_t ints = (n + 1 + 2 * a) * sizeof(int32_t);
+    size_t expected = sizeof(header) + m * sizeof(double) + align8(ints) + (a + a * m) * sizeof(double);
+    if (file.length < expected) throw std::runtime_error("truncated " + path);
+
+    // Every section starts on an 8-byte boundary of the page-aligned mapping
+    char* p = file.data + sizeof(header);
+    const double* res_max = reinterpret_cast<const double*>(p);
+    p += m * sizeof(double);
+    int32_t* offset = reinterpret_cast<int32_t*>(p);
+    int32_t* from = offset + n + 1;
+    int32_t* to = from + a;
+    p += align8(ints);
+    double* cost = reinterpret_cast<double*>(p);
+    double* res = cost + a;
+    if (offset[0] != 0 || static_cast<size_t>(offset[n]) != a) throw std::runtime_error("corrupt arc offsets in " + path);
+    // Every arc must lie in the range of its tail and point inside the graph
+    for (size_t v = 0; v < n; ++v) {
+        if (offset[v] > offset[v + 1]) throw std::runtime_error("corrupt arc offsets in " + path);
+        for (int32_t arc = offset[v]; arc < offset[v + 1]; ++arc) {
+            if (static_cast<size_t>(from[arc]) != v || to[arc] < 0 || static_cast<size_t>(to[arc]) >= n) {
+                throw std::runtime_error("corrupt arc " + std::to_string(arc) + " in " + path);
+            }
+        }
+    }
+
+    Graph graph(static_cast<int>(n), static_cast<int>(m), std::vector<double>(res_max, res_max + m));
+    std::vector<double> resources(m);
+    for (size_t arc = 0; arc < a; ++arc) {
+        resources.assign(res + arc * m, res + (arc + 1) * m);
+        graph.addEdge(from[arc], to[arc], cost[arc], resources);
+    }
+
+    // Arcs were added in out-CSR order, so edge ids equal arc indices and the
+    // forward CSR views the mapped file, which it keeps alive; only edge_id
+    // and the backward view are built.
+    static_assert(sizeof(int) == sizeof(int32_t), "CSR index arrays view the file's int32 arrays");
+    CSR& csr = graph.out_csr;
+    csr.num_res = static_cast<int>(m);
+    csr.backing = mapped;
+    csr.offset.view(reinterpret_cast<int*>(offset), n + 1);
+    csr.from.view(reinterpret_cast<int*>(from), a);
+    csr.to.view(reinterpret_cast<int*>(to), a);
+    csr.edge_id.resize(a);
+    std::iota(csr.edge_id.begin(), csr.edge_id.end(), 0);
+    csr.cost.view(cost, a);
+    csr.res.view(res, a * m);
+    graph.in_csr.build(graph.InList, graph.num_res);
+    graph.frozen = true;
+    graph.getDepotDistances();
+    return graph;
+}
+
+
+Graph loadInstance(const std::string& path) {
+    auto endsWith = [&path](const std::string& ext) {
+        return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+    };
+    if (endsWith(".bin")) return loadBinary(path);
+    if (endsWith(".csv")) return loadArcCSV(path);
+    return loadSolomon(path);
+}
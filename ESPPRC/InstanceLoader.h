@@ -0,0 +1,40 @@
+#ifndef INSTANCELOADER_H
+#define INSTANCELOADER_H
+
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+// Readers for benchmark instances. Vertex 0 is always the depot.
+// All loaders throw std::runtime_error on a missing or malformed file.
+
+// Solomon VRPTW file (CUSTOMER table with XCOORD, YCOORD, DEMAND, READY TIME,
+// DUE DATE, SERVICE TIME). The engine only handles additive resources, so two
+// are derived: load (demand of the head vertex, limit = vehicle capacity) and
+// time (service at the tail plus travel time, limit = depot due date). Time
+// windows are used to drop arcs that can never be on time. Travel times are
+// Euclidean distances truncated to one decimal; arc cost is the travel time
+// minus the dual of the tail vertex when duals are given.
+// num_customers > 0 keeps only the first customers (the usual 25/50 subsets).
+Graph loadSolomon(const std::string& path, int num_customers = 0, const std::vector<double>& duals = {});
+
+// Arc list in CSV form, '#' starts a comment line:
+//   nodes,<n>
+//   res_max,<r_0>,...,<r_m-1>
+//   from,to,cost,r_0,...,r_m-1      (optional header row)
+//   0,1,-2.5,1,3
+Graph loadArcCSV(const std::string& path);
+
+// Compact binary format: the out-CSR arrays of the graph, written as they lie
+// in memory. loadBinary maps the file copy-on-write and, after validating
+// it, lets Graph::out_csr view the mapped arrays instead of copying them (the
+// CSR keeps the mapping alive). The Edge objects the rest of the Graph API
+// works on, edge_id and the backward CSR are still built from the arrays, so
+// loading is not zero-copy: it skips the text parsing and the forward CSR copy.
+void saveBinary(const Graph& graph, const std::string& path);
+Graph loadBinary(const std::string& path);
+
+// Picks the loader from the extension: .bin, .csv, anything else is Solomon
+Graph loadInstance(const std::string& path);
+
+#endif // INSTANCELOADER_H
@@ -0,0 +1,79 @@
+#include "LPBounder.h"
+#include "Graph.h"
+
+LPBounder::LPBounder(Graph& graph) {
+    model = std::make_unique<GRBModel>(*graph.model);
+    model->set(GRB_IntParam_Method, 1);   // dual simplex re-optimizes best after bound changes
+    model->update();
+    num_vars = model->get(GRB_IntAttr_NumVars);
+    num_constrs = model->get(GRB_IntAttr_NumConstrs);
+    vars = model->getVars();
+    constrs = model->getConstrs();
+
+    // Both CSR views store an arc with its own endpoints: a backward label
+    // that enters csr.from[arc] from csr.to[arc] uses the arc from -> to too
+    for (bool dir : {true, false}) {
+        const CSR& csr = graph.getCSR(dir);
+        std::vector<int>& arc_var = dir ? out_var : in_var;
+        arc_var.assign(csr.size(), -1);
+        for (int arc = 0; arc < csr.size(); ++arc) {
+            auto it = graph.x_index.find({ csr.from[arc], csr.to[arc] });
+            if (it != graph.x_index.end()) arc_var[arc] = it->second;
+        }
+    }
+}
+
+LPBounder::~LPBounder() {
+    delete[] vars;
+    delete[] constrs;
+}
+
+// Take over the objective of Graph::model after Graph::updateCosts
+void LPBounder::updateCosts(Graph& graph) {
+    GRBVar* graph_vars = graph.model->getVars();
+    double* obj = graph.model->get(GRB_DoubleAttr_Obj, graph_vars, num_vars);
+    model->set(GRB_DoubleAttr_Obj, vars, obj, num_vars);
+    model->update();
+    delete[] obj;
+    delete[] graph_vars;
+}
+
+double LPBounder::solve(std::shared_ptr<const LPBasis>& basis_out) {
+    model->optimize();
+    num_solves++;
+    if (model->get(GRB_IntAttr_Status) != GRB_OPTIMAL) {
+        basis_out.reset();
+        return GRB_INFINITY;  // the forced arcs cannot be completed: prune
+    }
+    auto basis = std::make_shared<LPBasis>();
+    int* vb = model->get(GRB_IntAttr_VBasis, vars, num_vars);
+    int* cb = model->get(GRB_IntAttr_CBasis, constrs, num_constrs);
+    if (vb && cb) {
+        basis->vbasis.assign(vb, vb + num_vars);
+        basis->cbasis.assign(cb, cb + num_constrs);
+    }
+    delete[] vb;
+    delete[] cb;
+    basis_out = basis;
+    return model->get(GRB_DoubleAttr_ObjVal);
+}
+
+double LPBounder::rootBound(std::shared_ptr<const LPBasis>& basis_out) {
+    return solve(basis_out);
+}
+
+double LPBounder::bound(const std::vector<int>& forced, const LPBasis* warm_start, std::shared_ptr<const LPBasis>& basis_out) {
+    for (int var : forced) {
+        vars[var].set(GRB_DoubleAttr_LB, 1);
+    }
+    if (warm_start && !warm_start->vbasis.empty()) {
+        model->set(GRB_IntAttr_VBasis, vars, warm_start->vbasis.data(), num_vars);
+        model->set(GRB_IntAttr_CBasis, constrs, warm_start->cbasis.data(), num_constrs);
+    }
+    double value = solve(basis_out);
+    // Roll the model back to the root bounds for the next label
+    for (int var : forced) {
+        vars[var].set(GRB_DoubleAttr_LB, 0);
+    }
+    return value;
+}
@@ -0,0 +1,46 @@
+#ifndef LPBOUNDER_H
+#define LPBOUNDER_H
+
+#include <vector>
+#include <memory>
+#include <gurobi_c++.h>
+
+class Graph;
+
+// Simplex basis of the bounding LP, saved per label so its children can
+// warm start from it.
+struct LPBasis {
+    std::vector<int> vbasis;
+    std::vector<int> cbasis;
+};
+
+// One private copy of Graph::model per LabelManager; its solves are
+// serialized by LabelManager::LP_Mutex. A label is bounded by fixing the
+// lower bound of the x variables on its path to 1, re-solving with dual
+// simplex from its parent's basis and rolling the bounds back afterwards,
+// instead of deep-copying the model for every label.
+class LPBounder {
+public:
+    explicit LPBounder(Graph& graph);
+    ~LPBounder();
+    LPBounder(const LPBounder&) = delete;
+    LPBounder& operator=(const LPBounder&) = delete;
+
+    int arcVar(bool dir, int arc) const { return dir ? out_var[arc] : in_var[arc]; }
+    double rootBound(std::shared_ptr<const LPBasis>& basis_out);
+    double bound(const std::vector<int>& forced, const LPBasis* warm_start, std::shared_ptr<const LPBasis>& basis_out);
+    long long numSolves() const { return num_solves; }
+    void updateCosts(Graph& graph);
+
+private:
+    std::unique_ptr<GRBModel> model;
+    GRBVar* vars = nullptr;
+    GRBConstr* constrs = nullptr;
+    int num_vars = 0, num_constrs = 0;
+    std::vector<int> out_var, in_var;   // LP variable fixed by each CSR arc, -1 if none
+    long long num_solves = 0;
+
+    double solve(std::shared_ptr<const LPBasis>& basis_out);
+};
+
+#endif // LPBOUNDER_H
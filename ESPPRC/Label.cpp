@@ -2,56 +2,94 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <bit>
 
 Label::Label(Graph& graph, bool dir)
-    : vertex(0), path({ 0 }), cost(0),
+    : vertex(0), cost(0),
     resources(graph.num_res, 0),
-    reachable(graph.num_nodes, true), LB(0), id(0), rc(graph.num_edges, 0) { // Farzane: initialized "edges()"
+    reachable(graph.dssr.active() ? graph.dssr.size() : graph.num_nodes, true),
+    visited(graph.dssr.active() ? graph.dssr.size() : graph.num_nodes, false), LB(0), id(0), rc(graph.num_edges, 0) { // Farzane: initialized "edges()"
     status = LabelStatus::OPEN;
-    reachable[0] = false;
+    if (!graph.dssr.active()) {
+        reachable.reset(0);
+        visited.set(0);
+    }
     id = 0;
-    //std::cout << "Copying root model" << std::endl;
-    model = std::make_shared<GRBModel>(*graph.model);
-    model->update();
-    model->optimize();
-    LB = graph.model->get(GRB_DoubleAttr_ObjVal);
-    std::cout << "LB: " << LB << std::endl;
+    LB = graph.model ? graph.model->get(GRB_DoubleAttr_ObjVal) : 0;
     direction = dir;
     //LBImprove(graph);
     UpdateReachable(graph, 0);
+    reachable_count = reachable.count();
+    visited_count = visited.count();
 }
 
 // Farzane: passed pointer of MIP to the label
-Label::Label(const Label& parent, Graph& graph, const Edge* edge, const double UB)
-    : path(parent.path), cost(parent.cost),
-    resources(parent.resources), reachable(parent.reachable) {
-   
-    cost = parent.cost + edge->cost;
-    model = std::make_shared<GRBModel>(*parent.model);
-    model->getVar(graph.x_index[{edge->to,edge->from}]).set(GRB_DoubleAttr_LB, 1);
-    model->update();
-    model->optimize();
-    /*sep_model = std::make_shared<GRBModel>(*parent.sep_model);
-    sep_model->update();
-    sep_model->optimize();*/
-    LB = model->get(GRB_DoubleAttr_ObjVal);
-	direction = parent.direction;
-    vertex = direction? edge->to:edge->from;
-	if (direction) {
-		path.push_back(vertex);
-	}
-	else {
-		path.insert(path.begin(), vertex);
-	}
-    
-
-    reachable[vertex] = false;
-    reachable[0] = false;
+// Builds this label in place as the extension of parent_label along csr_arc
+// (an index into the CSR view of the parent's direction). Assigning instead
+// of constructing lets a recycled pool slot keep its buffers.
+// LB starts at the parent's bound; LabelManager::boundLabel tightens it.
+// Returns the number of vertices UpdateReachable dropped for resources.
+int Label::extendFrom(const Label& parent_label, LabelHandle parent_handle, Graph& graph, int csr_arc, const double UB) {
+    const CSR& csr = graph.getCSR(parent_label.direction);
+    const int from = csr.from[csr_arc], to = csr.to[csr_arc];
+    const double* arc_res = csr.resources(csr_arc);
+
+    id = -1;
+    parent = parent_handle;
+    arc = csr_arc;
+    length = parent_label.length + 1;
+    children = 0;
+    queued = false;
+    resources = parent_label.resources;
+    reachable = parent_label.reachable;
+    visited = parent_label.visited;
+    min_res.clear();
+
+    cost = parent_label.cost + csr.cost[csr_arc];
+    LB = parent_label.LB;
+    model.reset();
+    basis.reset();
+	direction = parent_label.direction;
+    vertex = direction ? to : from;
+    for (size_t i = 0; i < resources.size(); ++i) {
+        resources[i] += arc_res[i];
+    }
+    // No walk back to the depot (from it, backward) fits the remaining
+    // resources: this also rejects arcs that do not fit by themselves
+    const auto* rest = graph.to_depot.empty() ? nullptr : (direction ? &graph.to_depot : &graph.from_depot);
     for (size_t i = 0; i < resources.size(); ++i) {
-        resources[i] += edge->resources[i];
+        if (resources[i] + (rest ? (*rest)[i][vertex] : 0) > graph.res_max[i]) {
+            status = LabelStatus::DOMINATED;
+            return 0;
+        }
+    }
+    if (graph.dssr.active()) {
+        int slot = graph.dssr.slot(vertex);
+        if (slot >= 0) {
+            visited.set(slot);
+            reachable.reset(slot);
+        }
+    }
+    else {
+        if (graph.ng.active()) {
+            // ng-route memory: forget what is outside N(vertex), which may be
+            // visited again
+            const uint64_t* near = graph.ng[vertex].data();
+            uint64_t* memory = visited.data();
+            uint64_t* open = reachable.data();
+            for (int w = 0; w < visited.num_words(); ++w) {
+                open[w] |= memory[w] & ~near[w];
+                memory[w] &= near[w];
+            }
+        }
+        visited.set(vertex);
+        reachable.reset(vertex);
+        reachable.reset(0);
     }
     //LBImprove(graph);
-    UpdateReachable(graph, UB);
+    int rejected = UpdateReachable(graph, UB);
+    reachable_count = reachable.count();
+    visited_count = visited.count();
 
     /*LB = cost;
     for (int i = 0; i < graph.num_nodes; i++) {
@@ -61,18 +99,15 @@ Label::Label(const Label& parent, Graph& graph, const Edge* edge, const double U
     }*/
 
 
-    if (reachHalfPoint(graph.res_max, graph.num_nodes)) {
-        status = LabelStatus::NEW_CLOSED;
-    }
-    else {
-        status = LabelStatus::NEW_OPEN;
-    }
+    // Whether the label is past the half-way point is decided on insertion
+    // (LabelManager::acceptLabel), since the split point may move.
+    status = LabelStatus::NEW_OPEN;
 
     if (LB > UB) {
         status = LabelStatus::DOMINATED;
         //std::cout << "Pruned" << std::endl;
     }
-
+    return rejected;
 }
 
 
@@ -92,7 +127,7 @@ void Label::getUpdateMinRes(Graph& graph) {
         }
     }
 }
-void Label::UpdateReachable(Graph& graph, const double UB) {
+int Label::UpdateReachable(Graph& graph, const double UB) {
     //std::string var_name;
     //bool ind = true;
     //for (int i = 1; i < graph.num_nodes; ++i) {
@@ -116,40 +151,57 @@ void Label::UpdateReachable(Graph& graph, const double UB) {
     //}
     //getUpdateMinRes(graph);
 
-    for (const auto e : graph.OutList[vertex]) {
-        int neighbor = e->to;
-        if (reachable[neighbor]) {
+    // A vertex is unreachable once entering it and completing the route
+    // (forward), or coming from the depot and leaving it (backward), cannot
+    // fit, whatever arcs lead there. Unlike the former test of the arcs out of
+    // this vertex, this stays true for every descendant, which inherits
+    // reachable: a neighbor too far over its direct arc could still be
+    // cheaper to reach over another vertex. Single arcs that do not fit are
+    // rejected by extendFrom.
+    if (graph.to_depot.empty()) return 0;
+    const bool dssr = graph.dssr.active();
+    const auto& visit = direction ? graph.visit_fw : graph.visit_bw;
+    int rejected = 0;
+    uint64_t* words = reachable.data();
+    for (int w = 0; w < reachable.num_words(); ++w) {
+        for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+            int bit = (w << 6) + std::countr_zero(bits);
+            int v = dssr ? graph.dssr.vertices()[bit] : bit;
             for (int k = 0; k < graph.num_res; k++) {
-                if (resources[k] + e->resources[k] > graph.res_max[k]) {
-                    reachable[neighbor] = false;
+                if (resources[k] + visit[k][v] > graph.res_max[k]) {
+                    words[w] &= ~(1ULL << (bit & 63));
+                    ++rejected;
                     break;
                 }
             }
         }
     }
+    return rejected;
 }
 
 
-bool Label::reachHalfPoint(const std::vector<double>& res_max, int num_nodes) {
-    if (path.size() >= static_cast<double>(num_nodes) / 2) {
-        return true;
-    }
-    for (size_t i = 0; i < resources.size(); ++i) {
-        if (resources[i] >= res_max[i] / 2) {
-            return true;
-        }
-    }
-    return false;
+// Forward labels stop at limit = split, backward labels beyond limit =
+// res_max - split of the critical resource. For any route some forward prefix
+// then meets a backward suffix whose ancestors were all extended, however the
+// split was chosen. (The former any-resource / path-length test could close
+// both halves of a route before they met.)
+bool Label::reachHalfPoint(int crit, double limit) const {
+    return direction ? resources[crit] >= limit : resources[crit] > limit;
+}
+
+// Whether the label may be extended to v (under DSSR a non-critical customer
+// always may; extendFrom then checks the resources)
+bool Label::reaches(int v, const Graph& graph) const {
+    if (!graph.dssr.active()) return reachable[v];
+    int slot = graph.dssr.slot(v);
+    return slot >= 0 ? reachable[slot] : v != 0;
 }
 
 bool Label::isInPath(int node) const {
-    for (const int i : path) {
-        if (i == node) return true;
-    }
-    return false;
+    return visited[node];
 }
 
-void Label::display() const {
+void Label::display(const std::vector<int>& path) const {
     std::cout << "=========================\n";
     std::cout << "Path: ";
     for (int node : path) {
@@ -160,7 +212,7 @@ void Label::display() const {
         std::cout << resources[i] << (i + 1 < resources.size() ? ", " : "");
     }
     std::cout << "] Reachables: {";
-    for (size_t i = 0; i < reachable.size(); ++i) {
+    for (int i = 0; i < reachable.size(); ++i) {
         if (reachable[i]) {
             std::cout << i << (i + 1 < reachable.size() ? ", " : "");
         }
@@ -179,40 +231,55 @@ void Label::display() const {
 }
 
 DominanceStatus Label::DominanceCheck(const Label& rival) const {
-    bool dominates = true, dominated = true;
-
-    for (size_t i = 0; i < resources.size(); ++i) {
-        if (resources[i] > rival.resources[i]) dominates = false;
-        if (resources[i] < rival.resources[i]) dominated = false;
-        if (!dominates && !dominated) return DominanceStatus::INCOMPARABLE;
-    }
+    return dominanceKernel(cost, resources.data(), reachable.data(),
+        rival.cost, rival.resources.data(), rival.reachable.data(),
+        static_cast<int>(resources.size()), reachable.num_words(), reachable_count, rival.reachable_count);
+}
 
-    for (size_t i = 0; i < reachable.size(); ++i) {
-        if (reachable[i] < rival.reachable[i]) dominates = false;
-        if (reachable[i] > rival.reachable[i]) dominated = false;
-        if (!dominates && !dominated) return DominanceStatus::INCOMPARABLE;
-    }
+// Relaxed test for heuristic pricing: only the first num_res resources and,
+// optionally, no reachable sets (which makes it unsafe for exact pricing)
+DominanceStatus Label::DominanceCheck(const Label& rival, int num_res, bool use_reachable) const {
+    return dominanceKernel(cost, resources.data(), reachable.data(),
+        rival.cost, rival.resources.data(), rival.reachable.data(),
+        num_res, use_reachable ? reachable.num_words() : 0,
+        use_reachable ? reachable_count : 0, use_reachable ? rival.reachable_count : 0);
+}
 
-    if (dominates && cost <= rival.cost) return DominanceStatus::DOMINATES;
-    if (dominated && cost >= rival.cost) return DominanceStatus::DOMINATED;
-    return DominanceStatus::INCOMPARABLE;
+// ng-route dominance: the memory of the dominating label must be a subset of
+// the other's. The kernel tests a superset of a_bits, hence the swapped sets.
+DominanceStatus Label::NgDominanceCheck(const Label& rival, int num_res, bool use_memory) const {
+    return dominanceKernel(cost, resources.data(), rival.visited.data(),
+        rival.cost, rival.resources.data(), visited.data(),
+        num_res, use_memory ? visited.num_words() : 0,
+        use_memory ? rival.visited_count : 0, use_memory ? visited_count : 0);
 }
 
-bool Label::isConcatenable(const Label& label, const std::vector<double>& r_max) const {
+// Under ng-route the visited sets are memories, and under DSSR they only
+// cover the critical vertices, so the result may still contain a cycle.
+bool Label::isConcatenable(const Label& label, const Graph& graph) const {
     for (size_t i = 0; i < resources.size(); ++i) {
-        if (resources[i] + label.resources[i] > r_max[i]) {
+        if (resources[i] + label.resources[i] > graph.res_max[i]) {
             return false;
         }
     }
 
-    for (const int& i : path) {
-        if (i == vertex || i == 0) continue;
-        if (label.isInPath(i)) return false;
+    // The two partial paths may only share the junction vertex and the depot
+    // (which has no DSSR slot)
+    const bool dssr = graph.dssr.active();
+    const int junction = dssr ? graph.dssr.slot(vertex) : vertex;
+    const uint64_t* a = visited.data();
+    const uint64_t* b = label.visited.data();
+    for (int w = 0; w < visited.num_words(); ++w) {
+        uint64_t common = a[w] & b[w];
+        if (junction >= 0 && w == junction >> 6) common &= ~(1ULL << (junction & 63));
+        if (!dssr && w == 0) common &= ~1ULL;
+        if (common) return false;
     }
     return true;
 }
 
-void Label::LBImprove(Graph& graph) {
+void Label::LBImprove(Graph& graph, SolveStats& stats) {
+    STATS_PHASE(stats, Phase::LB_IMPROVE);
     while (true) {
         GRBLinExpr lhs = 0;
         double y_val = 0, x_val = 0;
@@ -5,9 +5,14 @@
 #include <unordered_set>
 #include "Graph.h"
 #include "Edge.h"
+#include "NodeSet.h"
+#include "Dominance.h"
+#include "LPBounder.h"
+#include "SolveStats.h"
 #include <gurobi_c++.h>
 #include <map>
 #include <memory>
+#include <cstdint>
 
 //#include "MIP1.h"
 
@@ -22,41 +27,51 @@ enum class LabelStatus {
     DOMINATED
 };
 
-enum class DominanceStatus {
-    DOMINATES,
-    DOMINATED,
-    INCOMPARABLE
-};
-
-
+// Labels live in a LabelPool and refer to each other through 32-bit handles
+using LabelHandle = uint32_t;
+constexpr LabelHandle NO_LABEL = UINT32_MAX;
 
 class Label {
 public:
     long long id = -1;
-    int vertex;
-    std::vector<int> path;
-    double cost;
+    int vertex = 0;
+    // The path is not stored; it is rebuilt from the parent chain (LabelStore::getPath)
+    LabelHandle parent = NO_LABEL;
+    int arc = -1;               // CSR arc (in this label's direction) that created it
+    int length = 1;             // number of vertices on the partial path
+    int children = 0;           // accepted children still referring to this label
+    bool queued = false;        // pending in the open queue
+    double cost = 0;
     std::vector<double> resources, rc;
-    std::vector<bool> reachable;
-	bool direction;
+    // Both sets are indexed by Graph::dssr slot instead of vertex while DSSR is active
+    NodeSet reachable;
+    NodeSet visited;            // vertices on the path, or only its ng-route memory while Graph::ng is active
+    int reachable_count = 0;    // reachable.count() and visited.count(), for the dominance early-out
+    int visited_count = 0;
+	bool direction = true;
     // Farzane: a vector of edges visited by the label
     /*std::vector<Edge> edges;*/
     // 
-    double LB;
-    LabelStatus status;
+    double LB = 0;
+    LabelStatus status = LabelStatus::OPEN;
     std::shared_ptr<GRBModel> model = nullptr;
     std::shared_ptr<GRBModel> sep_model = nullptr;
+    std::shared_ptr<const LPBasis> basis = nullptr;   // warm start for the children (BoundingMode::WARM_LP)
     std::map<std::pair<int, int>, double> min_res;
 
+    Label() = default;
     Label(Graph& graph,bool dir);
-    Label(const Label& parent, Graph& graph, const Edge* edge, const double UB);
+    int extendFrom(const Label& parent_label, LabelHandle parent_handle, Graph& graph, int csr_arc, const double UB);
 
-    void UpdateReachable(Graph& graph, const double UB);
-    bool reachHalfPoint(const std::vector<double>& res_max, int num_nodes);
-    void display() const;
+    int UpdateReachable(Graph& graph, const double UB);
+    bool reaches(int v, const Graph& graph) const;
+    bool reachHalfPoint(int crit, double limit) const;
+    void display(const std::vector<int>& path) const;
     DominanceStatus DominanceCheck(const Label& rival) const;
-    bool isConcatenable(const Label& bw_label, const std::vector<double>& r_max) const;
-    void LBImprove(Graph& graph);
+    DominanceStatus DominanceCheck(const Label& rival, int num_res, bool use_reachable) const;
+    DominanceStatus NgDominanceCheck(const Label& rival, int num_res, bool use_memory) const;
+    bool isConcatenable(const Label& bw_label, const Graph& graph) const;
+    void LBImprove(Graph& graph, SolveStats& stats);
     void getUpdateMinRes(Graph& graph);
     bool isInPath(int node) const;
 };
@@ -1,140 +1,492 @@
 #include "LabelManager.h"
 #include <iostream>
+#include <cmath>
 #include <memory>
+#include <thread>
+#include "WorkStealingPool.h"
+#include "Tracer.h"
+
+LabelManager::LabelManager(Graph& graph, BoundingMode mode)
+    : F_Store(graph.num_nodes), B_Store(graph.num_nodes), bounding(mode) {
+    if (!graph.frozen) graph.freeze();
+    crit_res = graph.criticalResource();
+    if (bounding == BoundingMode::WARM_LP) {
+        bounder = std::make_unique<LPBounder>(graph);
+    }
+    reset(graph);
+}
 
-LabelManager::LabelManager(Graph& graph) {
-    //std::cout << "Create Labels at source and sink" << std::endl;
-    Label source(graph,true);
-    DominanceCheckInsert(source, graph);
-	Label sink(graph, false);
-    DominanceCheckInsert(sink, graph);
-}
-
-
-void LabelManager::DominanceCheckInsert(Label& label, Graph& graph) {
-    int v = label.vertex;
-	std::vector<Label>& heap = label.direction ? F_Heap : B_Heap;
-    //std::vector<Label> tempHeap;
-    bool isDominated = false;
-    if (heap.empty()) {
-        ID++;
-        label.id = ID;
-        label.status = LabelStatus::OPEN;
-        heap.push_back(label);
-        std::push_heap(heap.begin(), heap.end(), CompareLabel());
-        return;
+
+// Forget all labels and solutions and start a new search from the roots.
+// The LP bounder and the label buffers are kept for the next solve.
+void LabelManager::reset(Graph& graph) {
+    UB = threshold;
+    solutions.clear();
+    column_paths.clear();
+    done = false;
+    heuristic_result = heuristic.active();
+    ng_route = graph.ng.active() && !graph.dssr.active();
+    cyclic = ng_route || graph.dssr.active();
+    F_New.clear();
+    B_New.clear();
+    F_Parked.clear();
+    B_Parked.clear();
+    F_Pending.clear();
+    B_Pending.clear();
+    ID = 0;
+    concat_ID = 0;
+    stats.reset();
+    if (crit_res >= 0) {
+        split = split_back = graph.res_max[crit_res] / 2;
     }
-    for (Label& rival : heap) {
-        if (label.vertex != rival.vertex) continue;
-        DominanceStatus status = label.DominanceCheck(rival);
-        if (status == DominanceStatus::DOMINATED)//new label is dominated by existing label
-            return;
-        else if (status == DominanceStatus::DOMINATES) {//new label dominates existing label
-            rival.status = LabelStatus::DOMINATED;
+    std::shared_ptr<const LPBasis> root_basis;
+    if (bounding == BoundingMode::WARM_LP) {
+        bounder->rootBound(root_basis);
+        STATS_ADD(stats, Counter::LP_SOLVES, 1);
+    }
+    // The LP bounds assume elementary completions, which ng-route and DSSR
+    // labels need not have: they are bounded by the completion DP instead
+    const bool completion_bounds = bounding == BoundingMode::COMPLETION || cyclic;
+    if (completion_bounds && !graph.completion.ready()) {
+        graph.getCompletionBounds();
+    }
+    cap_length = cyclic && graph.completion.countsArcs();
+    //std::cout << "Create Labels at source and sink" << std::endl;
+    for (bool dir : {true, false}) {
+        LabelStore& store = getStore(dir);
+        store.clear();
+        LabelHandle root = store.allocate();
+        store[root] = Label(graph, dir);
+        if (bounding == BoundingMode::MODEL_COPY) {
+            //std::cout << "Copying root model" << std::endl;
+            store[root].model = std::make_shared<GRBModel>(*graph.model);
+            store[root].model->update();
+            store[root].model->optimize();
+            STATS_ADD(stats, Counter::LP_SOLVES, 1);
         }
+        if (completion_bounds) {
+            store[root].LB = cyclic && graph.completion.countsArcs() ? -INFINITY : graph.completion.rootBound();
+        }
+        store[root].basis = root_basis;
+        DominanceCheckInsert(root, dir, graph);
     }
-    heap.erase(std::remove_if(heap.begin(), heap.end(),
-        [&](const Label& label) {
-            return (label.status == LabelStatus::DOMINATED || label.LB > UB);
-        }), heap.end());
+}
+
+
+// Pick up costs changed by Graph::updateCosts; call reset() before solving again
+void LabelManager::updateCosts(Graph& graph) {
+    if (bounder) bounder->updateCosts(graph);
+}
 
-    if (!isDominated) {
-        label.status = (label.status == LabelStatus::NEW_CLOSED) ? LabelStatus::CLOSED : LabelStatus::OPEN;
-        ID++;
-        //label.LBImprove(graph);
-        label.id = ID;
-        //label.display();
-        heap.push_back(label);
 
-        //std::cout << " Line 46" << std::endl;
-        std::push_heap(heap.begin(), heap.end(), CompareLabel());
+// Tighten the LB of a freshly extended label and prune it against UB
+// (label need not be in the store yet, its parent must be)
+void LabelManager::boundLabel(Label& label, const Label& parent, bool dir, Graph& graph) {
+    LabelStore& store = getStore(dir);
+    const CSR& csr = graph.getCSR(dir);
+    if (bounding == BoundingMode::COMPLETION || cyclic) {
+        STATS_PHASE(stats, Phase::COMPLETION_BOUND);
+        label.LB = cyclic && graph.completion.countsArcs() ? -INFINITY
+            : label.cost + graph.completion.completion(dir, label.vertex, label.resources, label.length);
+    }
+    else if (bounding == BoundingMode::MODEL_COPY) {
+        STATS_PHASE(stats, Phase::LP_BOUNDING);
+        std::lock_guard<std::mutex> lock(LP_Mutex);
+        TRACE_SPAN("LP re-solve");
+        label.model = std::make_shared<GRBModel>(*parent.model);
+        label.model->getVar(graph.x_index[{csr.from[label.arc], csr.to[label.arc]}]).set(GRB_DoubleAttr_LB, 1);
+        label.model->update();
+        label.model->optimize();
+        STATS_ADD(stats, Counter::LP_SOLVES, 1);
+        /*sep_model = std::make_shared<GRBModel>(*parent.sep_model);
+        sep_model->update();
+        sep_model->optimize();*/
+        label.LB = label.model->get(GRB_DoubleAttr_ObjVal);
+    }
+    else {
+        STATS_PHASE(stats, Phase::LP_BOUNDING);
+        std::lock_guard<std::mutex> lock(LP_Mutex);
+        TRACE_SPAN("LP re-solve");
+        forced.clear();
+        forced.push_back(bounder->arcVar(dir, label.arc));
+        if (forced.back() < 0) forced.pop_back();
+        for (LabelHandle h = label.parent; h != NO_LABEL; h = store[h].parent) {
+            if (store[h].arc < 0) continue;
+            int var = bounder->arcVar(dir, store[h].arc);
+            if (var >= 0) forced.push_back(var);
+        }
+        label.LB = bounder->bound(forced, parent.basis.get(), label.basis);
+        STATS_ADD(stats, Counter::LP_SOLVES, 1);
     }
+    if (label.LB > UB) {
+        label.status = LabelStatus::DOMINATED;
+        STATS_ADD(stats, Counter::BOUND_PRUNED, 1);
+    }
+}
+
 
+// Build child as the extension of parent along a CSR arc and bound it;
+// false if the child is already pruned by LB > UB
+bool LabelManager::buildChild(Label& child, const Label& parentLabel, LabelHandle parent, int arc, bool dir, Graph& graph) {
+    {
+        STATS_PHASE(stats, Phase::EXTENSION);
+        [[maybe_unused]] int rejected = child.extendFrom(parentLabel, parent, graph, arc, UB);
+        STATS_ADD(stats, Counter::LABELS_CREATED, 1);
+        STATS_ADD(stats, Counter::RESOURCE_REJECTED, rejected);
+    }
+    // No elementary partial path has more than num_nodes vertices
+    if (cap_length && child.length > graph.num_nodes) {
+        STATS_ADD(stats, Counter::RESOURCE_REJECTED, 1);
+        return false;
+    }
+    if (child.status == LabelStatus::DOMINATED) {
+        STATS_ADD(stats, Counter::BOUND_PRUNED, 1);
+        return false;
+    }
+    boundLabel(child, parentLabel, dir, graph);
+    return child.status != LabelStatus::DOMINATED;
 }
 
 
-bool LabelManager::isIDDuplicate(const long long fw_id, const long long bw_id) const {
+// Give a label that survived dominance its id and publish it to the vertex
+// bucket, the open queue and the next concatenation round. Batched callers
+// pass cap = false and call capVertex once every survivor is inserted:
+// a buffered child does not count on its parent yet, so an eviction could
+// otherwise recycle the parent under it.
+void LabelManager::acceptLabel(LabelHandle handle, bool dir, bool cap) {
+    LabelStore& store = getStore(dir);
+    Label& label = store[handle];
+    bool closed = crit_res >= 0 && label.reachHalfPoint(crit_res, dir ? split : split_back);
+    label.status = closed ? LabelStatus::CLOSED : LabelStatus::OPEN;
+    label.id = ++ID;
+    store.insert(handle);
+    (dir ? F_New : B_New).push_back({ handle, label.id });
+    if (closed) {
+        (dir ? F_Parked : B_Parked).push_back({ handle, label.id });
+    }
+    else {
+        store.pushOpen(handle);
+    }
+    if (cap) capVertex(dir, label.vertex);
+}
 
-    return IDs.find(std::make_pair(fw_id, bw_id)) != IDs.end();
-    //std::cout << " Line 64" << std::endl;
+
+// Heuristic cap: drop the most expensive labels of the vertex; queued and
+// parked references notice the status change.
+void LabelManager::capVertex(bool dir, int vertex) {
+    if (heuristic.max_labels_per_vertex <= 0) return;
+    LabelStore& store = getStore(dir);
+    const std::vector<LabelHandle>& bucket = store.atVertex(vertex);
+    while (static_cast<int>(bucket.size()) > heuristic.max_labels_per_vertex) {
+        store.remove(bucket.back());
+    }
 }
 
-void LabelManager::Propagate(Graph& graph) {
 
-    //if (labelHeap.front().status != LabelStatus::OPEN) return;
-	int neighbor;
-    // Get the top valid label
-    //std::cout << "Line 131" << std::endl;
+// Tilk et al.-style dynamic half-way point: shift the split towards the
+// direction with more open labels, then reopen parked labels that fall back
+// inside their direction's half. Labels already extended beyond the new split
+// stay extended, so concatenation remains exact for any split value.
+void LabelManager::moveSplit(const Graph& graph) {
+    if (halfway != HalfWayMode::DYNAMIC || crit_res < 0) return;
+    const double r_max = graph.res_max[crit_res];
+    const double step = r_max / 32;
+    int f_open = F_Store.numOpen(), b_open = B_Store.numOpen();
+    double moved = split;
+    if (f_open > 2 * b_open + 1) moved = std::max(0.0, split - step);
+    else if (b_open > 2 * f_open + 1) moved = std::min(r_max, split + step);
+    if (moved == split) return;
+    split = moved;
+    split_back = r_max - split;
+
     for (bool dir : {true, false}) {
-		std::vector<Label>& labelHeap = dir ? F_Heap : B_Heap;
-        std::pop_heap(labelHeap.begin(), labelHeap.end(), CompareLabel());  // Move best label to end
-        Label parentLabel = labelHeap.back();  // Store the best label
-        //std::cout << "Parent Label: " << std::endl;
-        //parentLabel.display();
-        labelHeap.pop_back();  // Remove from heap
-        if (parentLabel.LB <= UB) {
-            // Step 2: Process the best label (propagate children labels)
-            for (const auto& edge : dir?graph.OutList[parentLabel.vertex]: graph.InList[parentLabel.vertex]) {
-				neighbor = dir ? edge->to : edge->from;
-                if (parentLabel.reachable[neighbor]) {
-                    Label newLabel(parentLabel, graph, edge.get(), UB);  // Create new label
-
-                    if (newLabel.status != LabelStatus::DOMINATED) {
-                        DominanceCheckInsert(newLabel, graph);  // Insert new label into the heap if valid
-                    }
-                }
+        LabelStore& store = getStore(dir);
+        std::vector<LabelRef>& parked = dir ? F_Parked : B_Parked;
+        for (size_t i = 0; i < parked.size();) {
+            Label& label = store[parked[i].handle];
+            bool alive = label.id == parked[i].id && label.status == LabelStatus::CLOSED;
+            if (alive && label.reachHalfPoint(crit_res, dir ? split : split_back)) {
+                ++i;
+                continue;
+            }
+            if (alive) {
+                label.status = LabelStatus::OPEN;
+                store.pushOpen(parked[i].handle);
             }
-            parentLabel.status = LabelStatus::CLOSED;  // Close the parent label
-            labelHeap.push_back(parentLabel);  // Reinsert the parent label
-            std::push_heap(labelHeap.begin(), labelHeap.end(), CompareLabel());
+            parked[i] = parked.back();
+            parked.pop_back();
+        }
+    }
+}
 
 
+// Exact dominance, ng-route dominance on memories, or the relaxed test of
+// the heuristic mode; with cap_length the vertex count is compared as well
+DominanceStatus LabelManager::dominance(const Label& a, const Label& b) const {
+    auto test = [this](const Label& a, const Label& b) {
+        if (!ng_route && !heuristic.ignore_reachable && heuristic.dominance_resources < 0) return a.DominanceCheck(b);
+        int num_res = static_cast<int>(a.resources.size());
+        if (heuristic.dominance_resources >= 0) num_res = std::min(num_res, heuristic.dominance_resources);
+        if (ng_route) return a.NgDominanceCheck(b, num_res, !heuristic.ignore_reachable);
+        return a.DominanceCheck(b, num_res, !heuristic.ignore_reachable);
+    };
+    DominanceStatus status = test(a, b);
+    if (!cap_length) return status;
+    // DOMINATES also covers a tie, in which case b dominates a on length
+    if (status == DominanceStatus::DOMINATES && a.length > b.length) {
+        return test(b, a) == DominanceStatus::DOMINATES ? DominanceStatus::DOMINATED : DominanceStatus::INCOMPARABLE;
+    }
+    if (status == DominanceStatus::DOMINATED && a.length < b.length) return DominanceStatus::INCOMPARABLE;
+    return status;
+}
+
+
+// The same test as dominance(), for batches
+void LabelManager::configureSkyline(SkylineFilter& filter) const {
+    filter.configure(heuristic.dominance_resources, !heuristic.ignore_reachable, ng_route, cap_length);
+}
+
+
+// Deferred dominance of the children collected by one round: sorted by
+// vertex and cost, then each vertex group is filtered against its bucket in
+// one pass. All survivors are inserted before any dominated label is
+// removed or the heuristic cap evicts anything, so that a parent stays
+// referenced by its children.
+void LabelManager::filterPending(bool dir) {
+    STATS_PHASE(stats, Phase::DOMINANCE);
+    TRACE_SPAN("skyline dominance");
+    LabelStore& store = getStore(dir);
+    std::vector<LabelHandle>& pending = dir ? F_Pending : B_Pending;
+    std::sort(pending.begin(), pending.end(), [&store](LabelHandle a, LabelHandle b) {
+        if (store[a].vertex != store[b].vertex) return store[a].vertex < store[b].vertex;
+        return store[a].cost < store[b].cost;
+    });
+    SkylineFilter filter;
+    configureSkyline(filter);
+    std::vector<const Label*> existing, candidates;
+    std::vector<char> keep, removed;
+    std::vector<LabelHandle> losers;
+    std::vector<int> vertices;
+    for (size_t i = 0; i < pending.size();) {
+        const int vertex = store[pending[i]].vertex;
+        vertices.push_back(vertex);
+        size_t end = i;
+        while (end < pending.size() && store[pending[end]].vertex == vertex) ++end;
+        const std::vector<LabelHandle>& bucket = store.atVertex(vertex);
+        existing.clear();
+        candidates.clear();
+        for (LabelHandle handle : bucket) existing.push_back(&store[handle]);
+        for (size_t k = i; k < end; ++k) candidates.push_back(&store[pending[k]]);
+        filter.filter(existing, candidates, keep, removed);
+
+        for (size_t j = 0; j < bucket.size(); ++j) {
+            if (removed[j]) losers.push_back(bucket[j]);
+        }
+        for (size_t k = i; k < end; ++k) {
+            if (keep[k - i]) {
+                acceptLabel(pending[k], dir, false);
+            }
+            else {
+                STATS_ADD(stats, Counter::DOMINATED, 1);
+                store.discard(pending[k]);
+            }
         }
+        i = end;
+    }
+    for (LabelHandle loser : losers) {
+        STATS_ADD(stats, Counter::DOMINATING, 1);
+        store.remove(loser);
+    }
+    for (int vertex : vertices) {
+        capVertex(dir, vertex);
+    }
+    pending.clear();
+}
 
+
+// Returns false (and recycles the label) if an existing label dominates it
+bool LabelManager::DominanceCheckInsert(LabelHandle handle, bool dir, Graph& graph) {
+    LabelStore& store = getStore(dir);
+    Label& label = store[handle];
+    {
+        STATS_PHASE(stats, Phase::DOMINANCE);
+        // Only labels on the same vertex can dominate each other
+        const std::vector<LabelHandle>& rivals = store.atVertex(label.vertex);
+        for (size_t i = 0; i < rivals.size();) {
+            LabelHandle rival = rivals[i];
+            DominanceStatus status = dominance(label, store[rival]);
+            if (status == DominanceStatus::DOMINATED) {//new label is dominated by existing label
+                STATS_ADD(stats, Counter::DOMINATED, 1);
+                store.discard(handle);
+                return false;
+            }
+            else if (status == DominanceStatus::DOMINATES) {//new label dominates existing label
+                STATS_ADD(stats, Counter::DOMINATING, 1);
+                store.remove(rival);  // erased in place, the next rival moves to position i
+                continue;
+            }
+            ++i;
+        }
     }
-    
 
+    //label.display();
+    acceptLabel(handle, dir);
+    return true;
 }
 
 
+// Pop the best open label of one direction and extend it along its arcs
+void LabelManager::extendNext(bool dir, Graph& graph) {
+	int neighbor;
+	LabelStore& store = getStore(dir);
+    if (!store.hasOpen()) return;
+    TRACE_SPAN(dir ? "Propagate forward" : "Propagate backward");
+    LabelHandle parent = store.popOpen();
+    Label& parentLabel = store[parent];  // pool chunks never move while children are added
+    if (parentLabel.LB <= UB) {
+        // Step 2: Process the best label (propagate children labels)
+        const CSR& csr = graph.getCSR(dir);
+        for (int arc = csr.begin(parentLabel.vertex); arc < csr.end(parentLabel.vertex); ++arc) {
+			neighbor = dir ? csr.to[arc] : csr.from[arc];
+            if (parentLabel.reaches(neighbor, graph)) {
+                LabelHandle child = store.allocate();
+                if (!buildChild(store[child], parentLabel, parent, arc, dir, graph)) {  // Create new label
+                    store.discard(child);
+                }
+                else if (dominance_batch > 0) {
+                    (dir ? F_Pending : B_Pending).push_back(child);  // checked at the end of the round
+                }
+                else {
+                    DominanceCheckInsert(child, dir, graph);  // Insert new label into the store if valid
+                }
+            }
+        }
+    }
+    else {
+        STATS_ADD(stats, Counter::BOUND_PRUNED, 1);
+    }
+    parentLabel.status = LabelStatus::CLOSED;  // Close the parent label, it stays available for concatenation
+}
 
-void LabelManager::displayLabels() const {
-    for (const Label& label : F_Heap) {
-        label.display();
+// One round of a direction: a single label with immediate dominance, or up
+// to dominance_batch labels whose children are filtered together at the end
+void LabelManager::extendRound(bool dir, Graph& graph) {
+    if (dominance_batch <= 0) {
+        extendNext(dir, graph);
+        return;
     }
-    for (const Label& label : B_Heap) {
-        label.display();
+    LabelStore& store = getStore(dir);
+    for (int i = 0; i < dominance_batch && store.hasOpen(); ++i) {
+        extendNext(dir, graph);
     }
+    filterPending(dir);
 }
 
+void LabelManager::Propagate(Graph& graph) {
+    for (bool dir : {true, false}) {
+        extendRound(dir, graph);
+    }
+}
 
-void LabelManager::concatenateLabels(const Graph& graph) {
-    std::vector<int> path;
 
 
-    for (auto fit = F_Heap.begin(); fit != F_Heap.end(); ++fit) {
-        for (auto bit = B_Heap.begin(); bit != B_Heap.end() && bit != fit; ++bit) {
-            if (isIDDuplicate(fit->id, bit->id)) continue;
-            if (fit->vertex != bit->vertex || !fit->isConcatenable(*bit, graph.res_max)) {
-                IDs.insert({ fit->id, bit->id });
-                continue;
+void LabelManager::displayLabels() const {
+    for (const LabelStore* store : { &F_Store, &B_Store }) {
+        for (int v = 0; v < store->numVertices(); ++v) {
+            for (LabelHandle handle : store->atVertex(v)) {
+                (*store)[handle].display(store->getPath(handle));
             }
+        }
+    }
+}
 
-            double cost = fit->cost + bit->cost;
 
-            if (cost < UB) {
-                path = fit->path;
-                path.insert(path.end(), bit->path.begin() + 1, bit->path.end());
-                solutions.emplace_back(Solution(path, cost, { fit->id, bit->id }));
-                UB = cost;
-                //std::cout << "New UB: " << UB << std::endl;
-            }
-			IDs.insert({ fit->id, bit->id });
+// Join the labels created since the previous call with the opposite
+// direction at the same vertex. New forward labels meet every backward label,
+// new backward labels only the forward labels of earlier rounds, so each
+// pair is tested exactly once.
+void LabelManager::concatenateLabels(const Graph& graph) {
+    STATS_PHASE(stats, Phase::CONCATENATION);
+    TRACE_SPAN("concatenateLabels");
+    for (const LabelRef& fresh : F_New) {
+        if (F_Store[fresh.handle].id == fresh.id) joinLabel(fresh.handle, true, graph);
+    }
+    for (const LabelRef& fresh : B_New) {
+        if (B_Store[fresh.handle].id == fresh.id) joinLabel(fresh.handle, false, graph);
+    }
+    F_New.clear();
+    B_New.clear();
+    concat_ID = ID;
+}
+
+
+void LabelManager::joinLabel(LabelHandle handle, bool dir, const Graph& graph) {
+    LabelStore& own = getStore(dir);
+    LabelStore& other = getStore(!dir);
+    const Label& label = own[handle];
+    if (done || label.status == LabelStatus::DOMINATED || label.vertex == 0 || label.LB > UB) return;
+
+    // The bucket is sorted by cost: once the pair is too expensive, so is the rest
+    for (LabelHandle mate : other.atVertex(label.vertex)) {
+        const Label& rival = other[mate];
+        double cost = label.cost + rival.cost;
+        if (cost >= UB) break;
+        if (!dir && rival.id > concat_ID) continue;  // already joined from the forward side
+        STATS_ADD(stats, Counter::CONCAT_PAIRS, 1);
+        const Label& fw = dir ? label : rival;
+        const Label& bw = dir ? rival : label;
+        if (!fw.isConcatenable(bw, graph)) continue;
+
+        // Paths are only materialized for emitted solutions
+        std::vector<int> path = F_Store.getPath(dir ? handle : mate);
+        std::vector<int> bw_path = B_Store.getPath(dir ? mate : handle);
+        path.insert(path.end(), bw_path.begin() + 1, bw_path.end());
+        if (k_best > 0) {
+            addColumn(path, cost, { fw.id, bw.id });
+            if (done) return;
+            continue;
         }
+        solutions.emplace_back(Solution(path, cost, { fw.id, bw.id }));
+        UB = cost;
+        //std::cout << "New UB: " << UB << std::endl;
     }
 }
 
 
+// Column mode: keep solutions as a max-heap on cost of at most k_best
+// distinct paths. The same route is found once per vertex it can be split
+// at, hence the path set.
+void LabelManager::addColumn(std::vector<int>& path, double cost, std::pair<long long, long long> ids) {
+    auto worse = [](const Solution& a, const Solution& b) { return a.cost < b.cost; };
+    if (column_paths.count(path)) return;
+    if (static_cast<int>(solutions.size()) == k_best) {
+        std::pop_heap(solutions.begin(), solutions.end(), worse);
+        column_paths.erase(solutions.back().path);
+        solutions.pop_back();
+    }
+    column_paths.insert(path);
+    solutions.emplace_back(Solution(path, cost, ids));
+    std::push_heap(solutions.begin(), solutions.end(), worse);
+    if (static_cast<int>(solutions.size()) == k_best) {
+        if (stop_at_k) done = true;
+        UB = solutions.front().cost;
+    }
+}
+
+
+// Up to k distinct elementary paths with cost below threshold, cheapest
+// first. Restarts the search; the column settings stay in effect.
+const std::vector<Solution>& LabelManager::findColumns(Graph& graph, int k, double threshold, bool stop_at_k) {
+    this->k_best = std::max(k, 1);
+    this->threshold = threshold;
+    this->stop_at_k = stop_at_k;
+    reset(graph);
+    Run(graph);
+    std::sort(solutions.begin(), solutions.end(), [](const Solution& a, const Solution& b) { return a.cost < b.cost; });
+    return solutions;
+}
+
+
 void LabelManager::displaySolutions() const {
     for (const Solution& solution : solutions) {
         solution.display();
@@ -147,7 +499,173 @@ void LabelManager::displaySolutions() const {
 
 
 bool LabelManager::Terminate() {
-    return F_Heap.front().status != LabelStatus::OPEN || B_Heap.front().status != LabelStatus::OPEN;
+    return done || (!F_Store.hasOpen() && !B_Store.hasOpen());
+}
+
+
+// Forward and backward extension on two threads. A direction only ever adds
+// labels to its own store, so a thread is done once its open queue is empty.
+// After every extension step the thread joins the new labels of both
+// directions while holding both store mutexes, which also makes it the only
+// writer of UB and solutions at that moment.
+void LabelManager::RunParallel(Graph& graph) {
+    auto worker = [this, &graph](bool dir) {
+        while (!done) {
+            {
+                std::lock_guard<std::mutex> lock(getMutex(dir));
+                if (!getStore(dir).hasOpen()) break;
+                extendRound(dir, graph);
+            }
+            std::scoped_lock both(F_Mutex, B_Mutex);
+            concatenateLabels(graph);
+            moveSplit(graph);
+        }
+    };
+    // Moving the split may reopen labels of a direction whose thread has
+    // already finished, so restart until both queues stay empty.
+    do {
+        std::thread backward(worker, false);
+        worker(true);
+        backward.join();
+        concatenateLabels(graph);
+    } while (!Terminate());
+}
+
+
+// Batch-synchronous parallel labeling on a work-stealing pool. Each round
+//  1. pops up to batch_size open labels per direction,
+//  2. extends them in parallel into per-worker child buffers,
+//  3. resolves dominance in parallel, one SkylineFilter pass per
+//     (direction, vertex), so every bucket has a single owner and needs no lock,
+//  4. applies the outcome to the stores and concatenates, sequentially.
+// UB is read atomically by all workers for pruning.
+void LabelManager::RunWorkStealing(Graph& graph, int num_threads, int batch_size) {
+    WorkStealingPool pool(num_threads);
+    if (batch_size <= 0) batch_size = 16 * pool.size();
+
+    struct Parent {
+        LabelHandle handle;
+        bool dir;
+    };
+    struct Child {
+        int worker, index;
+        bool dir;
+        int vertex;
+        double cost;
+    };
+    std::vector<std::vector<Label>> buffers(pool.size());   // slots are reused round after round
+    std::vector<int> used(pool.size());
+    std::vector<Parent> batch;
+    std::vector<Child> children;
+    std::vector<std::pair<int, int>> groups;                // [begin, end) in children
+    std::vector<char> keep;
+    std::vector<std::vector<LabelHandle>> removals;
+    struct Scratch {
+        SkylineFilter filter;
+        std::vector<const Label*> existing, candidates;
+        std::vector<char> keep, removed;
+    };
+    std::vector<Scratch> scratch(pool.size());
+    for (Scratch& s : scratch) configureSkyline(s.filter);
+
+    while (!Terminate()) {
+        batch.clear();
+        for (bool dir : {true, false}) {
+            LabelStore& store = getStore(dir);
+            for (int taken = 0; taken < batch_size && store.hasOpen(); ++taken) {
+                LabelHandle handle = store.popOpen();
+                store[handle].status = LabelStatus::CLOSED;
+                if (store[handle].LB <= UB) batch.push_back({ handle, dir });
+                else STATS_ADD(stats, Counter::BOUND_PRUNED, 1);
+            }
+        }
+
+        // 2. extension into thread-local buffers
+        std::fill(used.begin(), used.end(), 0);
+        pool.parallelFor(static_cast<int>(batch.size()), [&](int i, int worker) {
+            const Parent& p = batch[i];
+            TRACE_SPAN(p.dir ? "Propagate forward" : "Propagate backward");
+            const Label& parentLabel = getStore(p.dir)[p.handle];
+            const CSR& csr = graph.getCSR(p.dir);
+            std::vector<Label>& buffer = buffers[worker];
+            for (int arc = csr.begin(parentLabel.vertex); arc < csr.end(parentLabel.vertex); ++arc) {
+                int neighbor = p.dir ? csr.to[arc] : csr.from[arc];
+                if (!parentLabel.reaches(neighbor, graph)) continue;
+                if (used[worker] == static_cast<int>(buffer.size())) buffer.emplace_back();
+                Label& child = buffer[used[worker]];
+                if (buildChild(child, parentLabel, p.handle, arc, p.dir, graph)) used[worker]++;
+            }
+        });
+
+        children.clear();
+        for (int w = 0; w < pool.size(); ++w) {
+            for (int i = 0; i < used[w]; ++i) {
+                const Label& child = buffers[w][i];
+                children.push_back({ w, i, child.direction, child.vertex, child.cost });
+            }
+        }
+        std::sort(children.begin(), children.end(), [](const Child& a, const Child& b) {
+            if (a.dir != b.dir) return a.dir;
+            if (a.vertex != b.vertex) return a.vertex < b.vertex;
+            return a.cost < b.cost;
+        });
+        groups.clear();
+        for (int i = 0; i < static_cast<int>(children.size());) {
+            int j = i;
+            while (j < static_cast<int>(children.size()) && children[j].dir == children[i].dir && children[j].vertex == children[i].vertex) ++j;
+            groups.emplace_back(i, j);
+            i = j;
+        }
+
+        // 3. dominance, one task per (direction, vertex)
+        keep.assign(children.size(), 0);
+        removals.resize(groups.size());
+        pool.parallelFor(static_cast<int>(groups.size()), [&](int g, int worker) {
+            STATS_PHASE(stats, Phase::DOMINANCE);
+            TRACE_SPAN("dominance");
+            auto [begin, end] = groups[g];
+            const LabelStore& store = getStore(children[begin].dir);
+            const std::vector<LabelHandle>& bucket = store.atVertex(children[begin].vertex);
+            Scratch& s = scratch[worker];
+            s.existing.clear();
+            s.candidates.clear();
+            for (LabelHandle rival : bucket) s.existing.push_back(&store[rival]);
+            for (int i = begin; i < end; ++i) s.candidates.push_back(&buffers[children[i].worker][children[i].index]);
+            s.filter.filter(s.existing, s.candidates, s.keep, s.removed);
+            for (int i = begin; i < end; ++i) {
+                keep[i] = s.keep[i - begin];
+                if (!keep[i]) STATS_ADD(stats, Counter::DOMINATED, 1);
+            }
+            removals[g].clear();
+            for (size_t j = 0; j < bucket.size(); ++j) {
+                if (!s.removed[j]) continue;
+                removals[g].push_back(bucket[j]);
+                STATS_ADD(stats, Counter::DOMINATING, 1);
+            }
+        });
+
+        // 4. apply: insert survivors first so their parents stay referenced
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (!keep[i]) continue;
+            LabelStore& store = getStore(children[i].dir);
+            Label& child = buffers[children[i].worker][children[i].index];
+            LabelHandle handle = store.allocate();
+            store[handle] = child;
+            child.model.reset();   // the buffer slot must not keep LP state alive
+            child.basis.reset();
+            acceptLabel(handle, children[i].dir, false);
+        }
+        for (size_t g = 0; g < groups.size(); ++g) {
+            for (LabelHandle rival : removals[g]) {
+                getStore(children[groups[g].first].dir).remove(rival);
+            }
+        }
+        for (const auto& [begin, end] : groups) {
+            capVertex(children[begin].dir, children[begin].vertex);
+        }
+        concatenateLabels(graph);
+        moveSplit(graph);
+    }
 }
 
 
@@ -155,6 +673,7 @@ void LabelManager::Run(Graph& graph) {
     while (!Terminate()) {
         Propagate(graph);
         concatenateLabels(graph);
+        moveSplit(graph);
 
     }
     /*concatenateLabels(graph);*/
@@ -164,3 +683,73 @@ void LabelManager::Run(Graph& graph) {
 }
 
 
+// ng-route labeling. Builds neighborhoods of ng_size nearest customers unless
+// Graph::ng is already active, and solves. The ng-route optimum is a lower
+// bound; if it is elementary it is the ESPPRC optimum. With grow, the cycles
+// of the returned paths (the best one, or every pooled column in column mode)
+// are added to the neighborhoods and the search is repeated until they are
+// all elementary; the grown neighborhoods are kept for later solves, call
+// graph.ng.clear() to go back to elementary labeling. Without grow the
+// returned paths may contain cycles. As in RunDSSR, cap_length keeps
+// resource-free cycles from being extended forever.
+const std::vector<Solution>& LabelManager::RunNgRoute(Graph& graph, int ng_size, bool grow) {
+    if (!graph.ng.active()) graph.ng.build(graph, ng_size);
+    while (true) {
+        reset(graph);
+        Run(graph);
+        if (!grow || solutions.empty()) break;
+        bool grown = false;
+        if (k_best > 0) {
+            for (const Solution& solution : solutions) grown |= graph.ng.grow(solution.path);
+        }
+        else {
+            grown = graph.ng.grow(solutions.back().path);
+        }
+        if (!grown) break;
+    }
+    if (grow) {
+        // earlier entries of the improving chain may still be cyclic
+        solutions.erase(std::remove_if(solutions.begin(), solutions.end(),
+            [](const Solution& s) { return !s.isElementary(); }), solutions.end());
+    }
+    if (k_best > 0) {
+        std::sort(solutions.begin(), solutions.end(), [](const Solution& a, const Solution& b) { return a.cost < b.cost; });
+    }
+    return solutions;
+}
+
+
+// Decremental state-space relaxation: solve with elementarity enforced only on
+// the critical vertices (initially the given ones unless Graph::dssr is
+// already active), add the customers the returned paths repeat (the best one,
+// or every pooled column in column mode) to the critical set and solve again
+// until they are elementary. Graph, bounder and label buffers are reused
+// between iterations. The critical set is kept for later solves; call
+// graph.dssr.clear() to go back to full elementarity. On graphs with arcs that
+// consume no resource the labels are limited to num_nodes vertices
+// (cap_length), so a resource-free negative cycle cannot be extended forever.
+const std::vector<Solution>& LabelManager::RunDSSR(Graph& graph, const std::vector<int>& initial) {
+    if (!graph.dssr.active()) {
+        graph.dssr.enable(graph.num_nodes);
+        for (int v : initial) graph.dssr.add(v);
+    }
+    while (true) {
+        reset(graph);
+        Run(graph);
+        if (solutions.empty()) break;
+        int added = 0;
+        if (k_best > 0) {
+            for (const Solution& solution : solutions) added += graph.dssr.addRepeated(solution.path);
+        }
+        else {
+            added = graph.dssr.addRepeated(solutions.back().path);
+        }
+        if (added == 0) break;
+    }
+    solutions.erase(std::remove_if(solutions.begin(), solutions.end(),
+        [](const Solution& s) { return !s.isElementary(); }), solutions.end());
+    if (k_best > 0) {
+        std::sort(solutions.begin(), solutions.end(), [](const Solution& a, const Solution& b) { return a.cost < b.cost; });
+    }
+    return solutions;
+}
@@ -7,6 +7,9 @@
 #include <map>
 #include <omp.h>
 #include "Label.h"
+#include "LabelStore.h"
+#include "SkylineFilter.h"
+#include "SolveStats.h"
 #include "Solution.h"
 #include "Graph.h"
 #include "Utils.h"
@@ -15,6 +18,8 @@
 #include <execution> 
 #include <algorithm>
 #include <unordered_set>
+#include <atomic>
+#include <mutex>
 
 //struct CompareLabel {
 //    bool operator()(const Label& a, const Label& b) const {
@@ -31,38 +36,111 @@
 //        return a.id < b.id;
 //    }
 //};
-struct CompareLabel {
-    bool operator()(const Label& a, const Label& b) const {
-        if (a.status != b.status) {
-            return a.status > b.status;
-        }
-        return a.LB > b.LB; // Min-heap: higher priority value means lower priority
-    }
+// How LabelManager computes Label::LB for new labels
+enum class BoundingMode {
+    MODEL_COPY,     // deep copy of the parent's GRBModel, cold re-solve (original scheme)
+    WARM_LP,        // one shared LPBounder, forced-arc bound deltas, dual simplex from the parent's basis
+    COMPLETION      // cost + precomputed Graph::completion bound, no LP solver involved
 };
-struct pair_hash {
-    std::size_t operator()(const std::pair<long long, long long>& p) const {
-        return std::hash<long long>()(p.first) ^ (std::hash<long long>()(p.second) << 1);
-    }
+
+// Half-way point between forward and backward search on the critical resource
+enum class HalfWayMode {
+    FIXED,      // res_max / 2
+    DYNAMIC     // moved during the search towards the direction with fewer open labels
+};
+
+// Relaxations of the heuristic pricing mode; the defaults are exact labeling
+struct HeuristicSettings {
+    int max_labels_per_vertex = 0;  // keep only the cheapest labels per vertex, 0 = no cap
+    bool ignore_reachable = false;  // dominance without the reachable-set condition
+    int dominance_resources = -1;   // resources compared in dominance (the first ones), -1 = all
+    bool active() const { return max_labels_per_vertex > 0 || ignore_reachable || dominance_resources >= 0; }
 };
+
+// A label kept aside (new since the last concatenation, or parked past the
+// half-way point); the id detects a pool slot that was recycled meanwhile.
+struct LabelRef {
+    LabelHandle handle;
+    long long id;
+};
+
 class LabelManager {
 public:
-    double UB = 0;
+    std::atomic<double> UB{ 0 };
     std::vector<Solution> solutions;
+    // Column mode (k_best > 0): solutions is a pool of the k cheapest distinct
+    // paths below threshold among those the search joins, UB is the threshold
+    // until the pool is full and the worst pooled cost afterwards. The best
+    // column is optimal; the others need not be the global runners-up, since
+    // dominance keeps only what the optimum needs. With stop_at_k the search
+    // ends as soon as k columns are pooled. k_best == 0 keeps the single
+    // improving chain of solutions, solutions.back() being the best.
+    int k_best = 0;
+    double threshold = 0;
+    bool stop_at_k = false;
+    std::atomic<bool> done{ false };
+    std::set<std::vector<int>> column_paths;
+    HeuristicSettings heuristic;
+    bool heuristic_result = false;  // the last search ran with relaxations: no optimality claim
+    bool ng_route = false;          // Graph::ng was active at reset(): dominance on the ng memories
+    bool cyclic = false;            // ng-route or DSSR: paths may contain cycles
+    // Cyclic labels on a graph whose arcs need not consume any resource
+    // (CompletionBound::countsArcs): a negative cycle could then be extended
+    // forever, so the vertex count is a resource limited to num_nodes
+    bool cap_length = false;
     //std::map<int, std::set<Label, CompareLabel>> Labels;
-    std::vector<Label> F_Heap,B_Heap;
-    std::unordered_set<std::pair<long long, long long>, pair_hash> IDs;
-    long long ID = 0;
+    LabelStore F_Store, B_Store;
+    std::vector<LabelRef> F_New, B_New;
+    std::vector<LabelRef> F_Parked, B_Parked;   // closed at the half-way point, never extended
+    // Deferred dominance: with dominance_batch > 0 a round extends up to that
+    // many open labels per direction and filters their children per vertex
+    // with a SkylineFilter instead of DominanceCheckInsert one by one
+    int dominance_batch = 0;
+    std::vector<LabelHandle> F_Pending, B_Pending;  // children of the current round, not yet checked
+    HalfWayMode halfway = HalfWayMode::FIXED;
+    int crit_res = -1;          // critical resource the half-way point is measured on
+    double split = 0;           // forward labels are extended while resources[crit_res] < split
+    double split_back = 0;      // backward labels while resources[crit_res] <= res_max - split
+    std::atomic<long long> ID{ 0 };
+    long long concat_ID = 0;   // largest label id already joined by concatenateLabels
+    BoundingMode bounding;
+    std::unique_ptr<LPBounder> bounder;
+    std::vector<int> forced;   // scratch: LP variables fixed by the label being bounded
+    // RunParallel: each direction thread holds its own mutex while extending,
+    // concatenation takes both. LP solves share one model and are serialized.
+    std::mutex F_Mutex, B_Mutex, LP_Mutex;
+    SolveStats stats;           // counters and phase times of the last solve, stats.toJSON() for a dump
 
-    LabelManager(Graph& graph);
+    LabelManager(Graph& graph, BoundingMode mode = BoundingMode::WARM_LP);
+    void reset(Graph& graph);
+    void updateCosts(Graph& graph);
 
-    void DominanceCheckInsert(Label& label, Graph& graph);
-    bool isIDDuplicate(const long long fw_id, const long long bw_id) const;
+    LabelStore& getStore(bool dir) { return dir ? F_Store : B_Store; }
+    std::mutex& getMutex(bool dir) { return dir ? F_Mutex : B_Mutex; }
+    bool DominanceCheckInsert(LabelHandle handle, bool dir, Graph& graph);
+    DominanceStatus dominance(const Label& a, const Label& b) const;
+    void configureSkyline(SkylineFilter& filter) const;
+    void filterPending(bool dir);
+    void boundLabel(Label& label, const Label& parent, bool dir, Graph& graph);
+    bool buildChild(Label& child, const Label& parentLabel, LabelHandle parent, int arc, bool dir, Graph& graph);
+    void acceptLabel(LabelHandle handle, bool dir, bool cap = true);
+    void capVertex(bool dir, int vertex);
+    void moveSplit(const Graph& graph);
     void displayLabels() const;
     void concatenateLabels(const Graph& graph);
+    void joinLabel(LabelHandle handle, bool dir, const Graph& graph);
+    void addColumn(std::vector<int>& path, double cost, std::pair<long long, long long> ids);
+    const std::vector<Solution>& findColumns(Graph& graph, int k, double threshold = -1e-6, bool stop_at_k = true);
     void displaySolutions() const;
+    void extendNext(bool dir, Graph& graph);
+    void extendRound(bool dir, Graph& graph);
     void Propagate(Graph& graph);
     bool Terminate();
     void Run(Graph& graph);
+    void RunParallel(Graph& graph);
+    void RunWorkStealing(Graph& graph, int num_threads, int batch_size = 0);
+    const std::vector<Solution>& RunNgRoute(Graph& graph, int ng_size = 8, bool grow = true);
+    const std::vector<Solution>& RunDSSR(Graph& graph, const std::vector<int>& initial = {});
 };
 
 #endif // LABELMANAGER_H
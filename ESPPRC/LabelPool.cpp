@@ -0,0 +1,31 @@
+#include "LabelPool.h"
+
+LabelHandle LabelPool::allocate() {
+    if (!free_list.empty()) {
+        LabelHandle handle = free_list.back();
+        free_list.pop_back();
+        return handle;
+    }
+    if ((next >> CHUNK_BITS) == chunks.size()) {
+        chunks.emplace_back(std::make_unique<Label[]>(static_cast<size_t>(1) << CHUNK_BITS));
+    }
+    return next++;
+}
+
+void LabelPool::release(LabelHandle handle) {
+    Label& label = (*this)[handle];
+    label.status = LabelStatus::DOMINATED;
+    label.model.reset();
+    label.sep_model.reset();
+    label.basis.reset();
+    free_list.push_back(handle);
+}
+
+// Drop every label but keep the chunks (and the buffers of their labels)
+void LabelPool::clear() {
+    for (LabelHandle handle = 0; handle < next; ++handle) {
+        release(handle);
+    }
+    free_list.clear();
+    next = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef LABELPOOL_H
+#define LABELPOOL_H
+
+#include <vector>
+#include <memory>
+#include "Label.h"
+
+// Chunked arena of labels addressed by 32-bit handles. Chunks never move, so
+// references stay valid while the pool grows, and released slots are recycled
+// through a free list so their vectors keep the capacity they already have.
+class LabelPool {
+public:
+    LabelHandle allocate();
+    void release(LabelHandle handle);
+    void clear();
+    Label& operator[](LabelHandle handle) { return chunks[handle >> CHUNK_BITS][handle & CHUNK_MASK]; }
+    const Label& operator[](LabelHandle handle) const { return chunks[handle >> CHUNK_BITS][handle & CHUNK_MASK]; }
+    int size() const { return static_cast<int>(next - free_list.size()); }
+    int capacity() const { return static_cast<int>(chunks.size()) << CHUNK_BITS; }
+
+private:
+    static constexpr int CHUNK_BITS = 12;
+    static constexpr LabelHandle CHUNK_MASK = (1u << CHUNK_BITS) - 1;
+    std::vector<std::unique_ptr<Label[]>> chunks;
+    std::vector<LabelHandle> free_list;
+    LabelHandle next = 0;
+};
+
+#endif // LABELPOOL_H
@@ -0,0 +1,106 @@
+#include "LabelStore.h"
+#include <algorithm>
+
+namespace {
+    struct BucketOrder {
+        const LabelPool* pool;
+        bool operator()(LabelHandle a, LabelHandle b) const {
+            const Label& x = (*pool)[a];
+            const Label& y = (*pool)[b];
+            if (x.cost != y.cost) return x.cost < y.cost;
+            return x.resources < y.resources;
+        }
+    };
+}
+
+LabelStore::LabelStore(int num_nodes) : at_vertex(num_nodes) {
+}
+
+// Give back a label that was built but never inserted
+void LabelStore::discard(LabelHandle handle) {
+    pool.release(handle);
+}
+
+void LabelStore::insert(LabelHandle handle) {
+    Label& label = pool[handle];
+    std::vector<LabelHandle>& bucket = at_vertex[label.vertex];
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), handle, BucketOrder{ &pool }), handle);
+    if (label.parent != NO_LABEL) {
+        pool[label.parent].children++;
+    }
+}
+
+void LabelStore::clear() {
+    pool.clear();
+    for (auto& bucket : at_vertex) bucket.clear();
+    open.clear();
+    live_open = 0;
+}
+
+// Mark a label dominated and drop it from its vertex bucket; a pending entry
+// in the open queue is discarded when it reaches the top.
+void LabelStore::remove(LabelHandle handle) {
+    Label& label = pool[handle];
+    if (label.queued && label.status == LabelStatus::OPEN) --live_open;
+    label.status = LabelStatus::DOMINATED;
+    std::vector<LabelHandle>& bucket = at_vertex[label.vertex];
+    auto it = std::find(std::lower_bound(bucket.begin(), bucket.end(), handle, BucketOrder{ &pool }), bucket.end(), handle);
+    if (it != bucket.end()) {
+        bucket.erase(it);
+    }
+    tryRelease(handle);
+}
+
+// Recycle a dominated label and, transitively, dominated ancestors that were
+// only kept alive as path predecessors.
+void LabelStore::tryRelease(LabelHandle handle) {
+    while (handle != NO_LABEL) {
+        Label& label = pool[handle];
+        if (label.status != LabelStatus::DOMINATED || label.children > 0 || label.queued) return;
+        LabelHandle parent = label.parent;
+        pool.release(handle);
+        if (parent == NO_LABEL) return;
+        pool[parent].children--;
+        handle = parent;
+    }
+}
+
+std::vector<int> LabelStore::getPath(LabelHandle handle) const {
+    std::vector<int> path;
+    bool forward = pool[handle].direction;
+    for (; handle != NO_LABEL; handle = pool[handle].parent) {
+        path.push_back(pool[handle].vertex);
+    }
+    // Walking the parents yields a forward path reversed, a backward path in order
+    if (forward) std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void LabelStore::pushOpen(LabelHandle handle) {
+    pool[handle].queued = true;
+    open.push(handle, pool[handle].LB);
+    ++live_open;
+}
+
+void LabelStore::dropStale() {
+    while (!open.empty() && pool[open.top()].status != LabelStatus::OPEN) {
+        LabelHandle handle = open.top();
+        open.pop();
+        pool[handle].queued = false;
+        tryRelease(handle);
+    }
+}
+
+bool LabelStore::hasOpen() {
+    dropStale();
+    return !open.empty();
+}
+
+LabelHandle LabelStore::popOpen() {
+    dropStale();
+    LabelHandle handle = open.top();
+    open.pop();
+    pool[handle].queued = false;
+    --live_open;
+    return handle;
+}
@@ -0,0 +1,48 @@
+#ifndef LABELSTORE_H
+#define LABELSTORE_H
+
+#include <vector>
+#include "Label.h"
+#include "LabelPool.h"
+#include "OpenQueue.h"
+
+// Labels of one search direction. Labels are allocated from a LabelPool and
+// handled through 32-bit handles; the non-dominated ones are indexed by vertex
+// so that dominance checks and concatenation only look at rivals on the same
+// vertex. Each vertex bucket is kept sorted by cost, then resources, so a join
+// against it can stop at the first label that is too expensive. Labels still
+// to be extended sit in a separate open queue (an OpenQueue radix heap on LB);
+// dominated entries are skipped lazily when the queue is popped.
+// A dominated label returns to the pool once no child refers to it anymore.
+class LabelStore {
+public:
+    explicit LabelStore(int num_nodes);
+
+    LabelHandle allocate() { return pool.allocate(); }
+    void discard(LabelHandle handle);
+    void insert(LabelHandle handle);
+    void remove(LabelHandle handle);
+    void clear();
+    Label& operator[](LabelHandle handle) { return pool[handle]; }
+    const Label& operator[](LabelHandle handle) const { return pool[handle]; }
+    const std::vector<LabelHandle>& atVertex(int v) const { return at_vertex[v]; }
+    std::vector<int> getPath(LabelHandle handle) const;
+
+    void pushOpen(LabelHandle handle);
+    LabelHandle popOpen();
+    bool hasOpen();
+    int numOpen() const { return live_open; }     // open labels, without stale queue entries
+    int numLabels() const { return pool.size(); }
+    int numVertices() const { return static_cast<int>(at_vertex.size()); }
+
+private:
+    LabelPool pool;
+    std::vector<std::vector<LabelHandle>> at_vertex;
+    OpenQueue open;
+    int live_open = 0;      // queued labels still OPEN; remove() invalidates entries
+
+    void dropStale();
+    void tryRelease(LabelHandle handle);
+};
+
+#endif // LABELSTORE_H
@@ -0,0 +1,48 @@
+#include "NgNeighborhoods.h"
+#include "Graph.h"
+#include <algorithm>
+#include <limits>
+
+void NgNeighborhoods::build(const Graph& graph, int size) {
+    const int n = graph.num_nodes;
+    const double INF = std::numeric_limits<double>::infinity();
+    std::vector<double> distance(static_cast<size_t>(n) * n, INF);
+    for (const auto& e : graph.edges) {
+        double& d = distance[static_cast<size_t>(std::min(e->from, e->to)) * n + std::max(e->from, e->to)];
+        d = std::min(d, e->cost);
+    }
+
+    sets.assign(n, NodeSet(n, false));
+    std::vector<int> order;
+    for (int i = 1; i < n; ++i) {
+        order.clear();
+        for (int j = 1; j < n; ++j) {
+            if (j != i) order.push_back(j);
+        }
+        auto dist = [&](int j) { return distance[static_cast<size_t>(std::min(i, j)) * n + std::max(i, j)]; };
+        int k = std::min(size, static_cast<int>(order.size()));
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+            [&](int a, int b) { return dist(a) != dist(b) ? dist(a) < dist(b) : a < b; });
+        sets[i].set(i);
+        for (int j = 0; j < k; ++j) sets[i].set(order[j]);
+    }
+}
+
+bool NgNeighborhoods::grow(const std::vector<int>& path) {
+    bool grown = false;
+    std::vector<int> last(sets.size(), -1);
+    for (int p = 0; p < static_cast<int>(path.size()); ++p) {
+        int v = path[p];
+        if (v == 0) continue;
+        if (last[v] >= 0) {
+            for (int q = last[v] + 1; q < p; ++q) {
+                if (!sets[path[q]][v]) {
+                    sets[path[q]].set(v);
+                    grown = true;
+                }
+            }
+        }
+        last[v] = p;
+    }
+    return grown;
+}
@@ -0,0 +1,34 @@
+#ifndef NGNEIGHBORHOODS_H
+#define NGNEIGHBORHOODS_H
+
+#include <vector>
+#include "NodeSet.h"
+
+class Graph;
+
+// ng-route relaxation (Baldacci, Mingozzi, Roberti). Every customer i has a
+// neighborhood N(i) containing i and its nearest customers. A label only
+// remembers the visited vertices that are in the neighborhood of every vertex
+// visited since, so it may revisit a vertex once it has been "forgotten".
+// Paths are therefore not necessarily elementary, but the labels' memories
+// are small and dominance much stronger. While no neighborhood is built
+// (active() false) labeling is fully elementary.
+class NgNeighborhoods {
+public:
+    // N(i) = i plus the size customers closest to i, by the cheaper of the
+    // arcs (i, j) and (j, i); customers without an arc to i come last.
+    void build(const Graph& graph, int size);
+    void clear() { sets.clear(); }
+    bool active() const { return !sets.empty(); }
+    const NodeSet& operator[](int v) const { return sets[v]; }
+    int size(int v) const { return sets[v].count(); }
+    // Dynamic neighborhoods: for every cycle v ... v of path add v to the
+    // neighborhoods of the vertices in between, which forbids the cycle from
+    // then on. False if nothing was added, i.e. path is elementary.
+    bool grow(const std::vector<int>& path);
+
+private:
+    std::vector<NodeSet> sets;
+};
+
+#endif // NGNEIGHBORHOODS_H
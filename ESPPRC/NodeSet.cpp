@@ -0,0 +1,24 @@
+#include "NodeSet.h"
+#include <bit>
+
+NodeSet::NodeSet(int n, bool value)
+    : words((n + 63) / 64, value ? ~0ULL : 0ULL), num_bits(n) {
+    if (value && (n & 63)) {
+        words.back() = (1ULL << (n & 63)) - 1;
+    }
+}
+
+int NodeSet::count() const {
+    int c = 0;
+    for (uint64_t w : words) {
+        c += std::popcount(w);
+    }
+    return c;
+}
+
+bool NodeSet::isSubsetOf(const NodeSet& other) const {
+    for (int i = 0; i < num_words(); ++i) {
+        if (words[i] & ~other.words[i]) return false;
+    }
+    return true;
+}
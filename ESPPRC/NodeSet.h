@@ -0,0 +1,30 @@
+#ifndef NODESET_H
+#define NODESET_H
+
+#include <vector>
+#include <cstdint>
+
+// Fixed-width bitset over the vertices of a graph, stored as 64-bit words so
+// that subset tests run word-wide (see Dominance.h). Bits past size() are
+// always zero.
+class NodeSet {
+public:
+    NodeSet() = default;
+    NodeSet(int n, bool value);
+
+    bool operator[](int i) const { return (words[i >> 6] >> (i & 63)) & 1ULL; }
+    void set(int i) { words[i >> 6] |= (1ULL << (i & 63)); }
+    void reset(int i) { words[i >> 6] &= ~(1ULL << (i & 63)); }
+    int size() const { return num_bits; }
+    int num_words() const { return static_cast<int>(words.size()); }
+    const uint64_t* data() const { return words.data(); }
+    uint64_t* data() { return words.data(); }
+    int count() const;
+    bool isSubsetOf(const NodeSet& other) const;
+
+private:
+    std::vector<uint64_t> words;
+    int num_bits = 0;
+};
+
+#endif // NODESET_H
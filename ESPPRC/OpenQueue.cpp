@@ -0,0 +1,52 @@
+#include "OpenQueue.h"
+#include <algorithm>
+#include <bit>
+
+// Order-preserving map of a double to unsigned: flip all bits of negative
+// numbers, only the sign bit of the others
+uint64_t OpenQueue::toKey(double value) {
+    uint64_t bits = std::bit_cast<uint64_t>(value);
+    return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+int OpenQueue::bucketOf(uint64_t key) const {
+    return key == last ? 0 : 64 - std::countl_zero(key ^ last);
+}
+
+void OpenQueue::push(LabelHandle handle, double value) {
+    uint64_t key = std::max(toKey(value), last);
+    buckets[bucketOf(key)].push_back({ key, handle });
+    ++count;
+}
+
+// Make bucket 0 non-empty: the smallest key of the first non-empty bucket
+// becomes last and that bucket's entries move to lower buckets
+void OpenQueue::refill() {
+    if (!buckets[0].empty()) return;
+    int i = 1;
+    while (buckets[i].empty()) ++i;
+    std::vector<Entry>& from = buckets[i];
+    last = std::min_element(from.begin(), from.end(),
+        [](const Entry& a, const Entry& b) { return a.key < b.key; })->key;
+    for (const Entry& entry : from) {
+        buckets[bucketOf(entry.key)].push_back(entry);
+    }
+    from.clear();
+}
+
+LabelHandle OpenQueue::top() {
+    refill();
+    return buckets[0].back().handle;
+}
+
+void OpenQueue::pop() {
+    refill();
+    buckets[0].pop_back();
+    --count;
+}
+
+void OpenQueue::clear() {
+    for (auto& bucket : buckets) bucket.clear();
+    last = 0;
+    count = 0;
+}
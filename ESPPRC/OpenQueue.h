@@ -0,0 +1,40 @@
+#ifndef OPENQUEUE_H
+#define OPENQUEUE_H
+
+#include <vector>
+#include <cstdint>
+#include "Label.h"
+
+// Monotone radix heap of open labels keyed by LB. A double maps to a 64-bit
+// key with the same order; an entry sits in the bucket of the highest bit in
+// which its key differs from the last popped key, so push is O(1) and each
+// entry is redistributed at most 64 times before it is popped. Keys below the
+// last popped one are raised to it: every bounding mode gives children an LB
+// no smaller than their parent's, so this only affects labels reopened by a
+// moving half-way point and labels without a bound (LB = -inf), which are
+// then taken in LIFO order. Entries are only handles; stale ones (dominated
+// or closed labels) are skipped by LabelStore when they reach the top.
+class OpenQueue {
+public:
+    void push(LabelHandle handle, double key);
+    LabelHandle top();
+    void pop();
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    void clear();
+
+private:
+    struct Entry {
+        uint64_t key;
+        LabelHandle handle;
+    };
+    std::vector<Entry> buckets[65];
+    uint64_t last = 0;
+    int count = 0;
+
+    static uint64_t toKey(double value);
+    int bucketOf(uint64_t key) const;
+    void refill();
+};
+
+#endif // OPENQUEUE_H
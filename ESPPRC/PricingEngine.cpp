@@ -0,0 +1,44 @@
+#include "PricingEngine.h"
+
+PricingEngine::PricingEngine(Graph& graph, BoundingMode mode) : graph(graph) {
+    elimination = graph.eliminateArcs();
+    graph.getMaxValue();
+    graph.getMinWeights();
+    graph.getCompletionBounds();
+    if (mode != BoundingMode::COMPLETION) {
+        if (!graph.model) graph.buildBaseModel();
+        if (!graph.sep_model) graph.buildSepModel();
+    }
+    manager = std::make_unique<LabelManager>(graph, mode);
+}
+
+void PricingEngine::updateCosts(const std::vector<double>& costs) {
+    graph.updateCosts(costs);
+    manager->updateCosts(graph);
+    fresh = false;
+}
+
+const std::vector<Solution>& PricingEngine::solve() {
+    // Leave the column mode an earlier findColumns switched on
+    manager->k_best = 0;
+    manager->threshold = 0;
+    manager->stop_at_k = false;
+    if (!fresh) manager->reset(graph);
+    fresh = false;
+    manager->Run(graph);
+    return manager->solutions;
+}
+
+const std::vector<Solution>& PricingEngine::findColumns(int k, double threshold, bool stop_at_k) {
+    fresh = false;
+    return manager->findColumns(graph, k, threshold, stop_at_k);
+}
+
+const std::vector<Solution>& PricingEngine::findColumnsEscalating(const HeuristicSettings& relaxed, int k, double threshold, bool stop_at_k) {
+    fresh = false;
+    manager->heuristic = relaxed;
+    const std::vector<Solution>& columns = manager->findColumns(graph, k, threshold, stop_at_k);
+    manager->heuristic = HeuristicSettings();
+    if (!columns.empty()) return columns;
+    return manager->findColumns(graph, k, threshold, stop_at_k);
+}
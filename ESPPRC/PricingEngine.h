@@ -0,0 +1,41 @@
+#ifndef PRICINGENGINE_H
+#define PRICINGENGINE_H
+
+#include <vector>
+#include <memory>
+#include "Graph.h"
+#include "LabelManager.h"
+
+// Persistent ESPPRC pricing for column generation. The graph, its Gurobi
+// models, the preprocessing and the LabelManager (with its LP bounder and
+// label buffers) are built once; between iterations only the arc costs
+// change, through updateCosts.
+class PricingEngine {
+public:
+    explicit PricingEngine(Graph& graph, BoundingMode mode = BoundingMode::WARM_LP);
+
+    // New reduced costs, indexed like Graph::edges (Edge::id)
+    void updateCosts(const std::vector<double>& costs);
+    // Runs the labeling on the current costs for the single best path, also
+    // after findColumns
+    const std::vector<Solution>& solve();
+    // Up to k columns with cost below threshold (see LabelManager::findColumns)
+    const std::vector<Solution>& findColumns(int k, double threshold = -1e-6, bool stop_at_k = true);
+    // Heuristic pricing first; the exact search only runs if it finds no
+    // column below threshold. isHeuristic() tells which one answered.
+    const std::vector<Solution>& findColumnsEscalating(const HeuristicSettings& relaxed, int k, double threshold = -1e-6, bool stop_at_k = true);
+    bool isHeuristic() const { return manager->heuristic_result; }
+    // What the resource-based arc elimination of the constructor removed
+    const ArcElimination& getElimination() const { return elimination; }
+
+    Graph& getGraph() { return graph; }
+    LabelManager& getManager() { return *manager; }
+
+private:
+    Graph& graph;
+    std::unique_ptr<LabelManager> manager;
+    ArcElimination elimination;
+    bool fresh = true;      // manager still holds the roots created by its constructor
+};
+
+#endif // PRICINGENGINE_H
@@ -0,0 +1,148 @@
+#include "PulseSolver.h"
+#include "WorkStealingPool.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <numeric>
+
+PulseSolver::PulseSolver(Graph& graph) : graph(graph), num_res(graph.num_res) {
+    if (!graph.frozen) graph.freeze();
+    if (!graph.completion.ready()) graph.getCompletionBounds();
+}
+
+
+// Arc order and lookup follow the current costs, so they are rebuilt per Run
+void PulseSolver::prepare() {
+    const CSR& csr = graph.getCSR(true);
+    const int n = graph.num_nodes;
+    order.resize(csr.size());
+    std::iota(order.begin(), order.end(), 0);
+    arc_index.assign(static_cast<size_t>(n) * n, -1);
+    for (int v = 0; v < n; ++v) {
+        std::sort(order.begin() + csr.begin(v), order.begin() + csr.end(v),
+            [&csr](int a, int b) { return csr.cost[a] < csr.cost[b]; });
+        for (int i = csr.begin(v); i < csr.end(v); ++i) {
+            int& slot = arc_index[static_cast<size_t>(v) * n + csr.to[order[i]]];
+            if (slot < 0) slot = order[i];
+        }
+    }
+}
+
+
+const std::vector<Solution>& PulseSolver::Run(int num_threads) {
+    UB = 0;
+    solutions.clear();
+    stats.reset();
+    prepare();
+
+    const CSR& csr = graph.getCSR(true);
+    std::vector<int> starts(order.begin() + csr.begin(0), order.begin() + csr.end(0));
+    WorkStealingPool pool(num_threads);
+    std::vector<Pulse> states(pool.size());
+    for (Pulse& state : states) {
+        state.visited.assign(graph.num_nodes, 0);
+        state.visited[0] = 1;
+    }
+    pool.parallelFor(static_cast<int>(starts.size()), [&](int i, int worker) {
+        TRACE_SPAN("pulse");
+        Pulse& state = states[worker];
+        const int arc = starts[i];
+        const double* arc_res = csr.resources(arc);
+        const int w = csr.to[arc];
+        if (w == 0) return;
+        state.path.assign({ 0, w });
+        state.cost.assign({ 0, csr.cost[arc] });
+        state.res.assign(2 * static_cast<size_t>(num_res), 0);
+        for (int k = 0; k < num_res; ++k) {
+            state.res[num_res + k] = arc_res[k];
+            if (arc_res[k] + graph.to_depot[k][w] > graph.res_max[k]) return;
+        }
+        state.visited[w] = 1;
+        pulse(state);
+        state.visited[w] = 0;
+    });
+    for (const Pulse& state : states) {
+        STATS_ADD(stats, Counter::LABELS_CREATED, state.pulses);
+        STATS_ADD(stats, Counter::BOUND_PRUNED, state.bound_pruned);
+        STATS_ADD(stats, Counter::RESOURCE_REJECTED, state.infeasible);
+        STATS_ADD(stats, Counter::ROLLBACK_PRUNED, state.rolled_back);
+    }
+    return solutions;
+}
+
+
+// Extends the path in state from its last vertex along every arc that
+// survives the three pruning rules; state is restored on return
+void PulseSolver::pulse(Pulse& state) {
+    const CSR& csr = graph.getCSR(true);
+    const int n = graph.num_nodes;
+    const int depth = static_cast<int>(state.path.size()) - 1;
+    const int v = state.path[depth];
+    const double cost = state.cost[depth];
+    ++state.pulses;
+
+    // the resources of a candidate extension go to the slot of depth + 1
+    state.res.resize(static_cast<size_t>(depth + 2) * num_res);
+    for (int i = csr.begin(v); i < csr.end(v); ++i) {
+        const int arc = order[i];
+        const int w = csr.to[arc];
+        const double* arc_res = csr.resources(arc);
+        const double* res = state.res.data() + static_cast<size_t>(depth) * num_res;
+        double* next = state.res.data() + static_cast<size_t>(depth + 1) * num_res;
+        const double next_cost = cost + csr.cost[arc];
+        if (w != 0 && state.visited[w]) continue;
+
+        bool feasible = true;
+        for (int k = 0; k < num_res && feasible; ++k) {
+            next[k] = res[k] + arc_res[k];
+            feasible = next[k] + graph.to_depot[k][w] <= graph.res_max[k];
+        }
+        if (!feasible) {
+            ++state.infeasible;
+            continue;
+        }
+        if (w == 0) {
+            if (next_cost < UB) record(state.path, next_cost);
+            continue;
+        }
+        if (next_cost + graph.completion.completion(true, w, next, depth + 2) >= UB) {
+            ++state.bound_pruned;
+            continue;
+        }
+        // Rollback: path[depth - 1] -> w directly is at least as good
+        if (depth >= 1) {
+            const int u = state.path[depth - 1];
+            const int shortcut = arc_index[static_cast<size_t>(u) * n + w];
+            if (shortcut >= 0 && state.cost[depth - 1] + csr.cost[shortcut] <= next_cost) {
+                const double* u_res = state.res.data() + static_cast<size_t>(depth - 1) * num_res;
+                const double* s_res = csr.resources(shortcut);
+                bool dominated = true;
+                for (int k = 0; k < num_res && dominated; ++k) {
+                    dominated = u_res[k] + s_res[k] <= next[k];
+                }
+                if (dominated) {
+                    ++state.rolled_back;
+                    continue;
+                }
+            }
+        }
+
+        state.path.push_back(w);
+        state.cost.push_back(next_cost);
+        state.visited[w] = 1;
+        pulse(state);
+        state.visited[w] = 0;
+        state.cost.pop_back();
+        state.path.pop_back();
+    }
+    state.res.resize(static_cast<size_t>(depth + 1) * num_res);
+}
+
+
+void PulseSolver::record(const std::vector<int>& path, double cost) {
+    std::lock_guard<std::mutex> lock(solution_mutex);
+    if (cost >= UB) return;
+    std::vector<int> route(path);
+    route.push_back(0);
+    solutions.emplace_back(Solution(route, cost, { -1, -1 }));
+    UB = cost;
+}
@@ -0,0 +1,54 @@
+#ifndef PULSESOLVER_H
+#define PULSESOLVER_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include "Graph.h"
+#include "Solution.h"
+#include "SolveStats.h"
+
+// Pulse algorithm (Lozano, Medaglia): exact ESPPRC by depth-first search from
+// the depot, an alternative to the best-first LabelManager on instances with
+// many resources. A partial path is pruned when
+//  - infeasible: some resource plus the least consumption back to the depot
+//    (Graph::to_depot) exceeds res_max,
+//  - bounded: its cost plus the completion bound (Graph::completion, which
+//    plays the role of the per-vertex primal bounds) cannot beat UB,
+//  - rolled back: skipping its last vertex, i.e. the arc from the
+//    second-to-last vertex straight to the new one, is neither more
+//    expensive nor consumes more of any resource.
+// The out-arcs of the depot are pulsed as independent tasks on a
+// WorkStealingPool sharing UB. Solutions mirror LabelManager: UB starts at 0
+// and solutions is the improving chain, solutions.back() the best path.
+class PulseSolver {
+public:
+    std::atomic<double> UB{ 0 };
+    std::vector<Solution> solutions;
+    SolveStats stats;   // labels_created counts pulses
+
+    explicit PulseSolver(Graph& graph);
+    const std::vector<Solution>& Run(int num_threads = 1);
+
+private:
+    // One DFS: the current path with the cost and resources of every prefix
+    struct Pulse {
+        std::vector<int> path;
+        std::vector<double> cost;       // cost[i]: cost of path[0..i]
+        std::vector<double> res;        // res[i * num_res + k]
+        std::vector<char> visited;
+        long long pulses = 0, bound_pruned = 0, infeasible = 0, rolled_back = 0;
+    };
+
+    Graph& graph;
+    int num_res;
+    std::vector<int> order;     // out-CSR arcs of every vertex, cheapest first
+    std::vector<int> arc_index; // [from * num_nodes + to]: cheapest out-CSR arc, -1 if none
+    std::mutex solution_mutex;
+
+    void prepare();
+    void pulse(Pulse& state);
+    void record(const std::vector<int>& path, double cost);
+};
+
+#endif // PULSESOLVER_H
@@ -0,0 +1,73 @@
+#include "SkylineFilter.h"
+#include <algorithm>
+
+void SkylineFilter::configure(int num_res, bool use_sets, bool ng_memory, bool use_length) {
+    res_limit = num_res;
+    this->use_sets = use_sets;
+    this->ng_memory = ng_memory;
+    this->use_length = use_length;
+}
+
+void SkylineFilter::pack(const Label& label, Rows& rows) const {
+    rows.cost.push_back(label.cost);
+    rows.res.insert(rows.res.end(), label.resources.begin(), label.resources.begin() + (num_res - use_length));
+    if (use_length) rows.res.push_back(label.length);
+    const NodeSet& set = ng_memory ? label.visited : label.reachable;
+    rows.bits.insert(rows.bits.end(), set.data(), set.data() + num_words);
+    rows.count.push_back(num_words ? (ng_memory ? label.visited_count : label.reachable_count) : 0);
+}
+
+// Same result as dominance(a, b) on the labels the rows were packed from
+DominanceStatus SkylineFilter::compare(const Rows& a, int i, const Rows& b, int j) const {
+    const uint64_t* a_bits = a.bits.data() + static_cast<size_t>(i) * num_words;
+    const uint64_t* b_bits = b.bits.data() + static_cast<size_t>(j) * num_words;
+    int a_count = a.count[i], b_count = b.count[j];
+    if (ng_memory) {
+        std::swap(a_bits, b_bits);
+        std::swap(a_count, b_count);
+    }
+    return dominanceKernel(a.cost[i], a.res.data() + static_cast<size_t>(i) * num_res, a_bits,
+        b.cost[j], b.res.data() + static_cast<size_t>(j) * num_res, b_bits, num_res, num_words, a_count, b_count);
+}
+
+void SkylineFilter::filter(const std::vector<const Label*>& existing, const std::vector<const Label*>& candidates,
+    std::vector<char>& keep, std::vector<char>& removed) {
+    keep.assign(candidates.size(), 0);
+    removed.assign(existing.size(), 0);
+    if (candidates.empty()) return;
+    const Label& first = *candidates.front();
+    num_res = static_cast<int>(first.resources.size());
+    if (res_limit >= 0) num_res = std::min(num_res, res_limit);
+    if (use_length) ++num_res;
+    num_words = use_sets ? (ng_memory ? first.visited : first.reachable).num_words() : 0;
+
+    old_rows.clear();
+    new_rows.clear();
+    for (const Label* label : existing) pack(*label, old_rows);
+    for (const Label* label : candidates) pack(*label, new_rows);
+
+    const int num_old = static_cast<int>(existing.size());
+    kept.clear();
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+        const double cost = new_rows.cost[i];
+        bool dominated = false;
+        for (int j = 0; j < num_old && old_rows.cost[j] <= cost && !dominated; ++j) {
+            dominated = compare(new_rows, i, old_rows, j) == DominanceStatus::DOMINATED;
+        }
+        for (size_t k = 0; k < kept.size() && !dominated; ++k) {
+            dominated = compare(new_rows, kept[k], new_rows, i) == DominanceStatus::DOMINATES;
+        }
+        if (!dominated) {
+            keep[i] = 1;
+            kept.push_back(i);
+        }
+    }
+    for (int j = 0; j < num_old; ++j) {
+        for (size_t k = 0; k < kept.size() && new_rows.cost[kept[k]] <= old_rows.cost[j]; ++k) {
+            if (compare(new_rows, kept[k], old_rows, j) == DominanceStatus::DOMINATES) {
+                removed[j] = 1;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SKYLINEFILTER_H
+#define SKYLINEFILTER_H
+
+#include <vector>
+#include <cstdint>
+#include "Label.h"
+
+// Batched dominance for the labels created at one vertex in one round. The
+// existing non-dominated labels and the candidates are packed into
+// contiguous cost / resource / bit-set rows, and the candidates are taken in
+// cost order, so each row is only compared with the rows that can dominate
+// it: those that are not more expensive. Pairs are tested with the SIMD
+// dominanceKernel. Ties go to the candidates, and among candidates to the
+// earlier one, as with one-at-a-time insertion.
+class SkylineFilter {
+public:
+    // num_res < 0 compares every resource; ng_memory tests subsets of the
+    // visited sets (ng-route) instead of supersets of the reachable sets;
+    // use_length compares Label::length as one more resource
+    void configure(int num_res, bool use_sets, bool ng_memory, bool use_length = false);
+    // existing and candidates sorted by cost; sets keep[i] for the surviving
+    // candidates and removed[j] for the existing labels a survivor dominates
+    void filter(const std::vector<const Label*>& existing, const std::vector<const Label*>& candidates,
+        std::vector<char>& keep, std::vector<char>& removed);
+
+private:
+    struct Rows {
+        std::vector<double> cost, res;
+        std::vector<uint64_t> bits;
+        std::vector<int> count;         // popcount of each bit-set row
+        void clear() { cost.clear(); res.clear(); bits.clear(); count.clear(); }
+    };
+    int res_limit = -1;
+    bool use_sets = true;
+    bool ng_memory = false;
+    bool use_length = false;
+    int num_res = 0, num_words = 0;     // row widths of the current batch (num_res includes the length)
+    Rows old_rows, new_rows;
+    std::vector<int> kept;              // surviving candidates, in cost order
+
+    void pack(const Label& label, Rows& rows) const;
+    DominanceStatus compare(const Rows& a, int i, const Rows& b, int j) const;
+};
+
+#endif // SKYLINEFILTER_H
@@ -1,4 +1,5 @@
 #include "Solution.h"
+#include <algorithm>
 
 Solution::Solution(const std::vector<int>& p, double c, std::pair<long long, long long> id)
     : path(p), cost(c), ID(id) {
@@ -12,3 +13,11 @@ void Solution::display() const {
     std::cout << ", Cost: " << cost << " \n";
 }
 
+// Customers appear at most once; the depot closes the route at both ends.
+// Only ng-route and DSSR searches can return paths that are not.
+bool Solution::isElementary() const {
+    std::vector<int> seen(path);
+    seen.erase(std::remove(seen.begin(), seen.end(), 0), seen.end());
+    std::sort(seen.begin(), seen.end());
+    return std::adjacent_find(seen.begin(), seen.end()) == seen.end();
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <iostream>
 #include <utility>
+#include <tuple>
 
 class Solution {
 public:
@@ -14,6 +15,7 @@ public:
     Solution(const std::vector<int>& p, double c, std::pair<long long, long long> id);
 
     void display() const;
+    bool isElementary() const;
 };
 
 #endif // SOLUTION_H
@@ -0,0 +1,55 @@
+#include "SolveStats.h"
+#include <fstream>
+#include <sstream>
+
+void SolveStats::reset() {
+    for (auto& c : counters) c.store(0, std::memory_order_relaxed);
+    for (auto& t : phase_ns) t.store(0, std::memory_order_relaxed);
+}
+
+const char* SolveStats::name(Counter c) {
+    switch (c) {
+    case Counter::LABELS_CREATED: return "labels_created";
+    case Counter::RESOURCE_REJECTED: return "resource_rejected";
+    case Counter::BOUND_PRUNED: return "bound_pruned";
+    case Counter::DOMINATED: return "dominated";
+    case Counter::DOMINATING: return "dominating";
+    case Counter::CONCAT_PAIRS: return "concat_pairs";
+    case Counter::LP_SOLVES: return "lp_solves";
+    case Counter::ROLLBACK_PRUNED: return "rollback_pruned";
+    default: return "unknown";
+    }
+}
+
+const char* SolveStats::name(Phase p) {
+    switch (p) {
+    case Phase::EXTENSION: return "extension";
+    case Phase::LP_BOUNDING: return "lp_bounding";
+    case Phase::COMPLETION_BOUND: return "completion_bound";
+    case Phase::DOMINANCE: return "dominance";
+    case Phase::CONCATENATION: return "concatenation";
+    case Phase::LB_IMPROVE: return "lb_improve";
+    default: return "unknown";
+    }
+}
+
+// {"counters": {...}, "phase_seconds": {...}}
+std::string SolveStats::toJSON() const {
+    std::ostringstream out;
+    out << "{\"counters\": {";
+    for (int i = 0; i < static_cast<int>(Counter::COUNT); ++i) {
+        out << (i ? ", " : "") << '"' << name(static_cast<Counter>(i)) << "\": " << get(static_cast<Counter>(i));
+    }
+    out << "}, \"phase_seconds\": {";
+    for (int i = 0; i < static_cast<int>(Phase::COUNT); ++i) {
+        out << (i ? ", " : "") << '"' << name(static_cast<Phase>(i)) << "\": " << seconds(static_cast<Phase>(i));
+    }
+    out << "}}";
+    return out.str();
+}
+
+bool SolveStats::writeJSON(const std::string& path) const {
+    std::ofstream out(path);
+    out << toJSON() << '\n';
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,83 @@
+#ifndef SOLVESTATS_H
+#define SOLVESTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Instrumentation of the labeling engine. Build with ESPPRC_STATS=0 to
+// compile every STATS_* hook out of the hot path.
+#ifndef ESPPRC_STATS
+#define ESPPRC_STATS 1
+#endif
+
+enum class Counter {
+    LABELS_CREATED,         // labels built by extension
+    RESOURCE_REJECTED,      // vertices made unreachable by resources in UpdateReachable
+    BOUND_PRUNED,           // labels dropped because LB > UB
+    DOMINATED,              // new labels rejected by dominance
+    DOMINATING,             // stored labels removed by a new label
+    CONCAT_PAIRS,           // forward/backward pairs tested in concatenation
+    LP_SOLVES,
+    ROLLBACK_PRUNED,        // pulses dropped by rollback pruning (PulseSolver)
+    COUNT
+};
+
+enum class Phase {
+    EXTENSION,
+    LP_BOUNDING,            // LB from the LP (MODEL_COPY / LP_BOUNDER)
+    COMPLETION_BOUND,       // LB from Graph::completion
+    DOMINANCE,
+    CONCATENATION,
+    LB_IMPROVE,             // separation rounds of Label::LBImprove
+    COUNT
+};
+
+// Counters and per-phase wall time, shared by all threads of a solve.
+// Updates are relaxed atomics; in the parallel runs phase times add up over
+// the threads.
+class SolveStats {
+public:
+    void add(Counter c, long long n = 1) { counters[static_cast<int>(c)].fetch_add(n, std::memory_order_relaxed); }
+    void addTime(Phase p, long long ns) { phase_ns[static_cast<int>(p)].fetch_add(ns, std::memory_order_relaxed); }
+    long long get(Counter c) const { return counters[static_cast<int>(c)].load(std::memory_order_relaxed); }
+    double seconds(Phase p) const { return phase_ns[static_cast<int>(p)].load(std::memory_order_relaxed) * 1e-9; }
+    void reset();
+    std::string toJSON() const;
+    bool writeJSON(const std::string& path) const;
+
+    static const char* name(Counter c);
+    static const char* name(Phase p);
+
+private:
+    std::atomic<long long> counters[static_cast<int>(Counter::COUNT)] = {};
+    std::atomic<long long> phase_ns[static_cast<int>(Phase::COUNT)] = {};
+};
+
+// Adds the lifetime of the scope to one phase
+class PhaseTimer {
+public:
+    PhaseTimer(SolveStats& s, Phase p) : stats(s), phase(p), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        stats.addTime(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    SolveStats& stats;
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+#if ESPPRC_STATS
+#define STATS_ADD(stats, counter, n) (stats).add(counter, n)
+#define STATS_PHASE(stats, phase) PhaseTimer STATS_CONCAT(phase_timer_, __LINE__)(stats, phase)
+#else
+#define STATS_ADD(stats, counter, n) ((void)0)
+#define STATS_PHASE(stats, phase) ((void)0)
+#endif
+
+#endif // SOLVESTATS_H
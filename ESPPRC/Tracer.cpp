@@ -0,0 +1,76 @@
+#include "Tracer.h"
+#include <fstream>
+#include <algorithm>
+#include <iomanip>
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : epoch(std::chrono::steady_clock::now()) {
+}
+
+int64_t Tracer::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Tracer::enable(size_t events_per_thread) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = std::max<size_t>(events_per_thread, 1);
+    for (auto& buffer : buffers) {
+        buffer->ring.assign(capacity, Event{});
+        buffer->written = 0;
+    }
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& buffer : buffers) {
+        buffer->written = 0;
+    }
+}
+
+// Buffers are never freed, so the cached pointer stays valid for the thread
+Tracer::ThreadBuffer& Tracer::local() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = buffers.back().get();
+        buffer->tid = static_cast<int>(buffers.size());
+        buffer->ring.assign(capacity, Event{});
+    }
+    return *buffer;
+}
+
+void Tracer::record(const char* name, int64_t begin_ns, int64_t end_ns) {
+    ThreadBuffer& buffer = local();
+    buffer.ring[buffer.written % buffer.ring.size()] = { name, begin_ns, end_ns };
+    buffer.written++;
+}
+
+// Complete ("X") events in microseconds, one track per recording thread
+bool Tracer::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& buffer : buffers) {
+        out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+            << ", \"args\": {\"name\": \"thread " << buffer->tid << "\"}}";
+        first = false;
+        size_t size = buffer->ring.size();
+        size_t begin = buffer->written > size ? buffer->written - size : 0;
+        for (size_t i = begin; i < buffer->written; ++i) {
+            const Event& e = buffer->ring[i % size];
+            out << ",\n{\"name\": \"" << e.name << "\", \"cat\": \"espprc\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid
+                << ", \"ts\": " << e.begin_ns / 1000.0 << ", \"dur\": " << (e.end_ns - e.begin_ns) / 1000.0 << "}";
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
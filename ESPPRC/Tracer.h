@@ -0,0 +1,82 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Optional timeline of the solve pipeline. While enabled, every TRACE_SPAN
+// records a complete event into a ring buffer owned by the calling thread
+// (the oldest events are overwritten when it is full); writeChromeTrace
+// emits Chrome Trace Event JSON that chrome://tracing and Perfetto load.
+// Disabled, a span costs one relaxed load. Build with ESPPRC_TRACING=0 to
+// remove the spans altogether.
+// enable/clear/writeChromeTrace must not run concurrently with traced code.
+#ifndef ESPPRC_TRACING
+#define ESPPRC_TRACING 1
+#endif
+
+class Tracer {
+public:
+    static Tracer& instance();
+
+    void enable(size_t events_per_thread = 1 << 16);
+    void disable() { active.store(false, std::memory_order_relaxed); }
+    bool enabled() const { return active.load(std::memory_order_relaxed); }
+    void clear();
+    // name must outlive the tracer (string literals)
+    void record(const char* name, int64_t begin_ns, int64_t end_ns);
+    int64_t now() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    struct Event {
+        const char* name;
+        int64_t begin_ns, end_ns;
+    };
+    struct ThreadBuffer {
+        int tid;
+        std::vector<Event> ring;
+        size_t written = 0;     // total events recorded, ring index is written % size
+    };
+
+    Tracer();
+    ThreadBuffer& local();
+
+    std::atomic<bool> active{ false };
+    size_t capacity = 1 << 16;
+    std::chrono::steady_clock::time_point epoch;
+    mutable std::mutex mutex;   // guards buffers (registration of new threads)
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// Records the lifetime of the scope as one span
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name(Tracer::instance().enabled() ? name : nullptr) {
+        if (this->name) begin = Tracer::instance().now();
+    }
+    ~TraceSpan() {
+        if (name) Tracer::instance().record(name, begin, Tracer::instance().now());
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    int64_t begin = 0;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#if ESPPRC_TRACING
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(name)
+#else
+#define TRACE_SPAN(name) ((void)0)
+#endif
+
+#endif // TRACER_H
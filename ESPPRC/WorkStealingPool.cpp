@@ -0,0 +1,102 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int num_threads) {
+    num_threads = std::max(num_threads, 1);
+    for (int i = 0; i < num_threads; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+    for (int i = 1; i < num_threads; ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    start_cv.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+bool WorkStealingPool::take(int id, std::pair<int, int>& range) {
+    {
+        Queue& own = *queues[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ranges.empty()) {
+            range = own.ranges.back();
+            own.ranges.pop_back();
+            return true;
+        }
+    }
+    for (int k = 1; k < size(); ++k) {
+        Queue& victim = *queues[(id + k) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            range = victim.ranges.front();
+            victim.ranges.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::drain(int id, const std::function<void(int, int)>& fn) {
+    std::pair<int, int> range;
+    while (take(id, range)) {
+        for (int i = range.first; i < range.second; ++i) {
+            fn(i, id);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        remaining -= range.second - range.first;
+        if (remaining == 0) done_cv.notify_all();
+    }
+}
+
+void WorkStealingPool::workerLoop(int id) {
+    long long seen = 0;
+    while (true) {
+        const std::function<void(int, int)>* fn;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return stop || generation != seen; });
+            if (stop) return;
+            seen = generation;
+            fn = job;
+            if (!fn) continue;  // woke up after that loop had already finished
+            busy++;
+        }
+        drain(id, *fn);
+        std::lock_guard<std::mutex> lock(mutex);
+        busy--;
+        if (busy == 0) done_cv.notify_all();
+    }
+}
+
+void WorkStealingPool::parallelFor(int count, const std::function<void(int, int)>& fn, int grain) {
+    if (count <= 0) return;
+    grain = std::max(grain, 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        int q = 0;
+        for (int begin = 0; begin < count; begin += grain) {
+            Queue& queue = *queues[q];
+            std::lock_guard<std::mutex> qlock(queue.mutex);
+            queue.ranges.emplace_back(begin, std::min(begin + grain, count));
+            q = (q + 1) % size();
+        }
+        job = &fn;
+        remaining = count;
+        generation++;
+    }
+    start_cv.notify_all();
+    drain(0, fn);
+    // Wait for stolen chunks still running and for every helper to leave drain,
+    // so none of them can pick up chunks of the next call with this fn.
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [&] { return remaining == 0 && busy == 0; });
+    job = nullptr;
+}
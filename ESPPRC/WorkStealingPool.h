@@ -0,0 +1,49 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <utility>
+
+// Persistent thread pool for data-parallel loops. parallelFor splits the index
+// range into chunks that are dealt round-robin to per-worker deques; a worker
+// pops its own deque from the back and, once it is empty, steals from the
+// front of the others. The calling thread takes part as worker 0.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int num_threads);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return static_cast<int>(queues.size()); }
+    // Runs fn(i, worker) for every i in [0, count) and returns once all are done
+    void parallelFor(int count, const std::function<void(int, int)>& fn, int grain = 1);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::pair<int, int>> ranges;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::mutex mutex;
+    std::condition_variable start_cv, done_cv;
+    const std::function<void(int, int)>* job = nullptr;
+    long long generation = 0;
+    int remaining = 0;      // indices not yet executed
+    int busy = 0;           // helper threads inside drain()
+    bool stop = false;
+
+    void workerLoop(int id);
+    void drain(int id, const std::function<void(int, int)>& fn);
+    bool take(int id, std::pair<int, int>& range);
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,117 @@
+// Tests.cpp
+// Regression checks of the labeling engines on small hand-built graphs.
+// Every check prints its result; the exit code is the number of failures.
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <vector>
+#include "BucketGraphSolver.h"
+#include "Graph.h"
+#include "InstanceLoader.h"
+#include "LabelManager.h"
+
+namespace {
+
+int failures = 0;
+
+void check(const std::string& name, bool ok) {
+    std::cout << (ok ? "PASS " : "FAIL ") << name << std::endl;
+    if (!ok) ++failures;
+}
+
+double bestCost(const std::vector<Solution>& solutions) {
+    return solutions.empty() ? INFINITY : solutions.back().cost;
+}
+
+// Depot 0 and customers 1, 2, 3 with one resource. The 2-cycle 1 <-> 2 is
+// negative and consumes nothing, so only elementarity bounds it; the best
+// elementary route is 0-1-2-0 (or 0-2-1-0) with cost -3.
+Graph zeroResourceCycle() {
+    Graph graph(4, 1, { 10 });
+    graph.addEdge(0, 1, 1, { 1 });
+    graph.addEdge(0, 2, 1, { 1 });
+    graph.addEdge(0, 3, 1, { 1 });
+    graph.addEdge(1, 0, 1, { 1 });
+    graph.addEdge(2, 0, 1, { 1 });
+    graph.addEdge(3, 0, 1, { 1 });
+    graph.addEdge(1, 2, -5, { 0 });
+    graph.addEdge(2, 1, -5, { 0 });
+    graph.addEdge(2, 3, 2, { 1 });
+    graph.addEdge(3, 2, 2, { 1 });
+    graph.freeze();
+    graph.getMaxValue();
+    graph.getMinWeights();
+    return graph;
+}
+
+void testDSSRZeroResourceCycle() {
+    Graph graph = zeroResourceCycle();
+    LabelManager manager(graph, BoundingMode::COMPLETION);
+    const std::vector<Solution>& solutions = manager.RunDSSR(graph);
+    check("DSSR on a zero-resource negative 2-cycle", std::abs(bestCost(solutions) + 3) < 1e-9
+        && solutions.back().isElementary());
+}
+
+void testNgRouteZeroResourceCycle() {
+    Graph graph = zeroResourceCycle();
+    LabelManager manager(graph, BoundingMode::COMPLETION);
+    const std::vector<Solution>& solutions = manager.RunNgRoute(graph, 2, true);
+    check("ng-route on a zero-resource negative 2-cycle", std::abs(bestCost(solutions) + 3) < 1e-9
+        && solutions.back().isElementary());
+}
+
+// The bucket graph has no ng dominance, so it must refuse ng neighborhoods
+// instead of labeling without them.
+void testBucketGraphRejectsNg() {
+    Graph graph = zeroResourceCycle();
+    graph.ng.build(graph, 2);
+    bool thrown = false;
+    try {
+        BucketGraphSolver solver(graph);
+        solver.Run();
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check("bucket graph rejects ng neighborhoods", thrown);
+}
+
+// loadBinary lets the forward CSR view the mapped file: the graph must stay
+// valid when copied, and updateCosts must not write through to the file.
+void testBinaryRoundTrip() {
+    const std::string path = "tests_roundtrip.bin";
+    Graph graph = zeroResourceCycle();
+    saveBinary(graph, path);
+    std::vector<double> costs(graph.num_edges, 1);
+    double loaded, updated, reloaded;
+    {
+        Graph mapped = loadBinary(path);
+        LabelManager manager(mapped, BoundingMode::COMPLETION);
+        loaded = bestCost(manager.RunDSSR(mapped));
+        mapped.updateCosts(costs);
+        Graph copy = mapped;
+        mapped = Graph(1, 1, { 0 });
+        LabelManager copy_manager(copy, BoundingMode::COMPLETION);
+        updated = bestCost(copy_manager.RunDSSR(copy));
+    }
+    Graph again = loadBinary(path);
+    LabelManager manager(again, BoundingMode::COMPLETION);
+    reloaded = bestCost(manager.RunDSSR(again));
+    std::remove(path.c_str());
+    check("binary round trip", std::abs(loaded + 3) < 1e-9 && std::isinf(updated)
+        && std::abs(reloaded + 3) < 1e-9);
+}
+
+}
+
+
+int main() {
+    testDSSRZeroResourceCycle();
+    testNgRouteZeroResourceCycle();
+    testBucketGraphRejectsNg();
+    testBinaryRoundTrip();
+    std::cout << failures << " failure(s)" << std::endl;
+    return failures;
+}